@@ -20,6 +20,9 @@
 #include <assert.h>
 #include <stdarg.h>
 #include <stdlib.h>
+#if defined(__i386__) || (defined(__x86_64__) && !defined(__arm64ec__))
+#include <intrin.h>
+#endif
 
 #include "ntstatus.h"
 #define WIN32_NO_STATUS
@@ -432,6 +435,195 @@ NTSTATUS WINAPI BCryptGetFipsAlgorithmMode(BOOLEAN *enabled)
     return STATUS_SUCCESS;
 }
 
+#if (defined(__i386__) || (defined(__x86_64__) && !defined(__arm64ec__))) && defined(__GNUC__)
+
+static BOOL sha_ext_supported;
+
+static void init_sha_ext(void)
+{
+    int regs[4];
+
+    __cpuid( regs, 0 );
+    if (regs[0] < 7) return;
+    __cpuid( regs, 1 );
+    if (!(regs[2] & (1 << 9)) || !(regs[2] & (1 << 19))) return; /* SSSE3, SSE4.1 */
+    __cpuidex( regs, 7, 0 );
+    sha_ext_supported = !!(regs[1] & (1 << 29));
+}
+
+/* 4 rounds on W[4g..4g+3], then advance the message schedule of the following groups */
+#define SHA1_ROUNDS(g, f) \
+    e[(g) & 1] = _mm_sha1nexte_epu32( e[(g) & 1], msg[(g) & 3] ); \
+    e[((g) & 1) ^ 1] = abcd; \
+    abcd = _mm_sha1rnds4_epu32( abcd, e[(g) & 1], f ); \
+    if ((g) >= 1 && (g) <= 16) msg[((g) + 3) & 3] = _mm_sha1msg1_epu32( msg[((g) + 3) & 3], msg[(g) & 3] ); \
+    if ((g) >= 2 && (g) <= 17) msg[((g) + 2) & 3] = _mm_xor_si128( msg[((g) + 2) & 3], msg[(g) & 3] ); \
+    if ((g) >= 3 && (g) <= 18) msg[((g) + 1) & 3] = _mm_sha1msg2_epu32( msg[((g) + 1) & 3], msg[(g) & 3] );
+
+__attribute__((target("sha,sse4.1")))
+static void sha1_compress_ext( ulong32 *state, const unsigned char *buf, unsigned long blocks )
+{
+    const __m128i mask = _mm_set_epi64x( 0x0001020304050607ull, 0x08090a0b0c0d0e0full );
+    __m128i abcd, abcd_save, e_save, e[2], msg[4];
+    unsigned int i;
+
+    abcd = _mm_shuffle_epi32( _mm_loadu_si128( (const __m128i *)state ), 0x1b );
+    e_save = _mm_set_epi32( state[4], 0, 0, 0 );
+
+    for (; blocks; blocks--, buf += 64)
+    {
+        abcd_save = abcd;
+        for (i = 0; i < 4; i++)
+            msg[i] = _mm_shuffle_epi8( _mm_loadu_si128( (const __m128i *)(buf + 16 * i) ), mask );
+
+        e[0] = _mm_add_epi32( e_save, msg[0] );
+        e[1] = abcd;
+        abcd = _mm_sha1rnds4_epu32( abcd, e[0], 0 );
+
+        SHA1_ROUNDS( 1, 0) SHA1_ROUNDS( 2, 0) SHA1_ROUNDS( 3, 0) SHA1_ROUNDS( 4, 0)
+        SHA1_ROUNDS( 5, 1) SHA1_ROUNDS( 6, 1) SHA1_ROUNDS( 7, 1) SHA1_ROUNDS( 8, 1)
+        SHA1_ROUNDS( 9, 1) SHA1_ROUNDS(10, 2) SHA1_ROUNDS(11, 2) SHA1_ROUNDS(12, 2)
+        SHA1_ROUNDS(13, 2) SHA1_ROUNDS(14, 2) SHA1_ROUNDS(15, 3) SHA1_ROUNDS(16, 3)
+        SHA1_ROUNDS(17, 3) SHA1_ROUNDS(18, 3) SHA1_ROUNDS(19, 3)
+
+        /* e[0] holds the state before the last 4 rounds, the other lanes stay zero */
+        e_save = _mm_sha1nexte_epu32( e[0], e_save );
+        abcd = _mm_add_epi32( abcd, abcd_save );
+    }
+
+    _mm_storeu_si128( (__m128i *)state, _mm_shuffle_epi32( abcd, 0x1b ) );
+    state[4] = _mm_extract_epi32( e_save, 3 );
+}
+
+#undef SHA1_ROUNDS
+
+static const ulong32 sha256_k[64] =
+{
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+};
+
+__attribute__((target("sha,sse4.1")))
+static void sha256_compress_ext( ulong32 *state, const unsigned char *buf, unsigned long blocks )
+{
+    const __m128i mask = _mm_set_epi64x( 0x0c0d0e0f08090a0bull, 0x0405060700010203ull );
+    __m128i state0, state1, abef, cdgh, msg[4], tmp;
+    unsigned int i;
+
+    /* the round instructions keep the state as ABEF/CDGH */
+    tmp    = _mm_shuffle_epi32( _mm_loadu_si128( (const __m128i *)&state[0] ), 0xb1 );
+    state1 = _mm_shuffle_epi32( _mm_loadu_si128( (const __m128i *)&state[4] ), 0x1b );
+    state0 = _mm_alignr_epi8( tmp, state1, 8 );
+    state1 = _mm_blend_epi16( state1, tmp, 0xf0 );
+
+    for (; blocks; blocks--, buf += 64)
+    {
+        abef = state0;
+        cdgh = state1;
+        for (i = 0; i < 4; i++)
+            msg[i] = _mm_shuffle_epi8( _mm_loadu_si128( (const __m128i *)(buf + 16 * i) ), mask );
+
+        /* 4 rounds per iteration, W[4i+16..4i+19] replaces W[4i..4i+3] */
+        for (i = 0; i < 16; i++)
+        {
+            tmp    = _mm_add_epi32( msg[i & 3], _mm_loadu_si128( (const __m128i *)&sha256_k[4 * i] ) );
+            state1 = _mm_sha256rnds2_epu32( state1, state0, tmp );
+            tmp    = _mm_shuffle_epi32( tmp, 0x0e );
+            state0 = _mm_sha256rnds2_epu32( state0, state1, tmp );
+            if (i < 12)
+            {
+                tmp = _mm_sha256msg1_epu32( msg[i & 3], msg[(i + 1) & 3] );
+                tmp = _mm_add_epi32( tmp, _mm_alignr_epi8( msg[(i + 3) & 3], msg[(i + 2) & 3], 4 ) );
+                msg[i & 3] = _mm_sha256msg2_epu32( tmp, msg[(i + 3) & 3] );
+            }
+        }
+
+        state0 = _mm_add_epi32( state0, abef );
+        state1 = _mm_add_epi32( state1, cdgh );
+    }
+
+    tmp    = _mm_shuffle_epi32( state0, 0x1b );
+    state1 = _mm_shuffle_epi32( state1, 0xb1 );
+    state0 = _mm_blend_epi16( tmp, state1, 0xf0 );
+    state1 = _mm_alignr_epi8( state1, tmp, 8 );
+    _mm_storeu_si128( (__m128i *)&state[0], state0 );
+    _mm_storeu_si128( (__m128i *)&state[4], state1 );
+}
+
+/* same buffering as the tomcrypt process functions, but full blocks are compressed in one go */
+static int process_blocks( ulong64 *length, ulong32 *curlen, unsigned char *buf, ulong32 *state,
+                           void (*compress)( ulong32 *, const unsigned char *, unsigned long ),
+                           const unsigned char *in, unsigned long inlen )
+{
+    unsigned long n;
+
+    if (*curlen > 64) return CRYPT_INVALID_ARG;
+    if (*length + inlen < *length) return CRYPT_HASH_OVERFLOW;
+
+    if (*curlen)
+    {
+        n = min( inlen, 64 - *curlen );
+        memcpy( buf + *curlen, in, n );
+        *curlen += n;
+        in += n;
+        inlen -= n;
+        if (*curlen < 64) return CRYPT_OK;
+        compress( state, buf, 1 );
+        *length += 64 * 8;
+        *curlen = 0;
+    }
+    if ((n = inlen / 64))
+    {
+        compress( state, in, n );
+        *length += (ulong64)n * 64 * 8;
+        in += n * 64;
+        inlen -= n * 64;
+    }
+    memcpy( buf, in, inlen );
+    *curlen = inlen;
+    return CRYPT_OK;
+}
+
+static int sha1_process_ext( hash_state *md, const unsigned char *in, unsigned long inlen )
+{
+    return process_blocks( &md->sha1.length, &md->sha1.curlen, md->sha1.buf, md->sha1.state,
+                           sha1_compress_ext, in, inlen );
+}
+
+static int sha256_process_ext( hash_state *md, const unsigned char *in, unsigned long inlen )
+{
+    return process_blocks( &md->sha256.length, &md->sha256.curlen, md->sha256.buf, md->sha256.state,
+                           sha256_compress_ext, in, inlen );
+}
+
+/* the padding done by sha*_done() is left to the portable code */
+static const struct ltc_hash_descriptor sha1_ext_desc =
+{
+    "sha1", 2, 20, 64, { 1, 3, 14, 3, 2, 26 }, 6,
+    sha1_init, sha1_process_ext, sha1_done, sha1_test, NULL
+};
+
+static const struct ltc_hash_descriptor sha256_ext_desc =
+{
+    "sha256", 0, 32, 64, { 2, 16, 840, 1, 101, 3, 4, 2, 1 }, 9,
+    sha256_init, sha256_process_ext, sha256_done, sha256_test, NULL
+};
+
+#else
+
+static const BOOL sha_ext_supported = FALSE;
+static void init_sha_ext(void) {}
+#define sha1_ext_desc sha1_desc
+#define sha256_ext_desc sha256_desc
+
+#endif
+
 static const struct ltc_hash_descriptor *get_hash_descriptor( enum alg_id alg_id )
 {
     switch (alg_id)
@@ -439,8 +631,8 @@ static const struct ltc_hash_descriptor *get_hash_descriptor( enum alg_id alg_id
     case ALG_ID_MD2: return &md2_desc;
     case ALG_ID_MD4: return &md4_desc;
     case ALG_ID_MD5: return &md5_desc;
-    case ALG_ID_SHA1: return &sha1_desc;
-    case ALG_ID_SHA256: return &sha256_desc;
+    case ALG_ID_SHA1: return sha_ext_supported ? &sha1_ext_desc : &sha1_desc;
+    case ALG_ID_SHA256: return sha_ext_supported ? &sha256_ext_desc : &sha256_desc;
     case ALG_ID_SHA384: return &sha384_desc;
     case ALG_ID_SHA512: return &sha512_desc;
     default:
@@ -2752,6 +2944,7 @@ BOOL WINAPI DllMain( HINSTANCE hinst, DWORD reason, LPVOID reserved )
     {
     case DLL_PROCESS_ATTACH:
         DisableThreadLibraryCalls( hinst );
+        init_sha_ext();
         if (!__wine_init_unix_call())
         {
             if (UNIX_CALL( process_attach, NULL)) __wine_unixlib_handle = 0;
@@ -416,6 +416,65 @@ static void test_hashes(void)
         test_hash(tests+i);
 }
 
+static void test_hash_chunks(void)
+{
+    static const struct
+    {
+        const WCHAR *alg;
+        ULONG hash_size;
+        const char *hash;
+    }
+    tests[] =
+    {
+        { L"SHA1", 20, "33f233c97a803d84a0db9f3dbc05b63ff2045d92" },
+        { L"SHA256", 32, "59425e4412e296fc74736673ce067027f384203f59c0d2c3e6be7b13347b3ffc" },
+    };
+    /* chunk sizes around the 64 byte block size and the 56 byte padding limit */
+    static const ULONG chunk_sizes[] = { 1, 55, 56, 63, 64, 65, 127, 128, 129, 1000 };
+    UCHAR data[1000], buf[512], hash_buf[32];
+    BCRYPT_ALG_HANDLE alg;
+    BCRYPT_HASH_HANDLE hash;
+    ULONG i, j, pos, len;
+    char str[65];
+    NTSTATUS ret;
+
+    for (i = 0; i < sizeof(data); i++) data[i] = (i * 7) % 251;
+
+    for (i = 0; i < ARRAY_SIZE(tests); i++)
+    {
+        alg = NULL;
+        ret = BCryptOpenAlgorithmProvider(&alg, tests[i].alg, MS_PRIMITIVE_PROVIDER, 0);
+        ok(ret == STATUS_SUCCESS, "got %#lx\n", ret);
+
+        for (j = 0; j < ARRAY_SIZE(chunk_sizes); j++)
+        {
+            hash = NULL;
+            ret = BCryptCreateHash(alg, &hash, buf, sizeof(buf), NULL, 0, 0);
+            ok(ret == STATUS_SUCCESS, "got %#lx\n", ret);
+
+            for (pos = 0; pos < sizeof(data); pos += len)
+            {
+                len = min(chunk_sizes[j], sizeof(data) - pos);
+                ret = BCryptHashData(hash, data + pos, len, 0);
+                ok(ret == STATUS_SUCCESS, "got %#lx\n", ret);
+            }
+
+            memset(hash_buf, 0, sizeof(hash_buf));
+            ret = BCryptFinishHash(hash, hash_buf, tests[i].hash_size, 0);
+            ok(ret == STATUS_SUCCESS, "got %#lx\n", ret);
+            format_hash( hash_buf, tests[i].hash_size, str );
+            ok(!strcmp(str, tests[i].hash), "%s, chunk size %lu: got %s\n",
+               wine_dbgstr_w(tests[i].alg), chunk_sizes[j], str);
+
+            ret = BCryptDestroyHash(hash);
+            ok(ret == STATUS_SUCCESS, "got %#lx\n", ret);
+        }
+
+        ret = BCryptCloseAlgorithmProvider(alg, 0);
+        ok(ret == STATUS_SUCCESS, "got %#lx\n", ret);
+    }
+}
+
 static void test_BcryptHash(void)
 {
     static const char expected[] =
@@ -4490,6 +4549,7 @@ START_TEST(bcrypt)
     test_BCryptGenRandom();
     test_BCryptGetFipsAlgorithmMode();
     test_hashes();
+    test_hash_chunks();
     test_BcryptHash();
     test_BcryptDeriveKeyPBKDF2();
     test_rng();
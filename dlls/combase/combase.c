@@ -126,7 +126,13 @@ struct registered_class
     unsigned int rpcss_cookie;
 };
 
-static struct list registered_classes = LIST_INIT(registered_classes);
+/* registered classes, hashed by CLSID */
+static struct list registered_classes[64];
+
+static struct list *get_registered_classes_bucket(REFCLSID clsid)
+{
+    return &registered_classes[clsid->Data1 % ARRAY_SIZE(registered_classes)];
+}
 
 static CRITICAL_SECTION registered_classes_cs;
 static CRITICAL_SECTION_DEBUG registered_classes_cs_debug =
@@ -144,7 +150,7 @@ IUnknown * com_get_registered_class_object(const struct apartment *apt, REFCLSID
 
     EnterCriticalSection(&registered_classes_cs);
 
-    LIST_FOR_EACH_ENTRY(cur, &registered_classes, struct registered_class, entry)
+    LIST_FOR_EACH_ENTRY(cur, get_registered_classes_bucket(rclsid), struct registered_class, entry)
     {
         if ((apt->oxid == cur->apartment_id) &&
             (clscontext & cur->clscontext) &&
@@ -304,12 +310,25 @@ static LSTATUS open_classes_key(HKEY hkey, const WCHAR *name, REGSAM access, HKE
 HRESULT open_key_for_clsid(REFCLSID clsid, const WCHAR *keyname, REGSAM access, HKEY *subkey)
 {
     static const WCHAR clsidW[] = L"CLSID\\";
-    WCHAR path[CHARS_IN_GUID + ARRAY_SIZE(clsidW) - 1];
+    WCHAR path[CHARS_IN_GUID + ARRAY_SIZE(clsidW) + 32];
+    unsigned int len;
     LONG res;
     HKEY key;
 
     lstrcpyW(path, clsidW);
     StringFromGUID2(clsid, path + lstrlenW(clsidW), CHARS_IN_GUID);
+    len = lstrlenW(path);
+
+    /* open the subkey directly, the class key is only needed to find out why that failed */
+    if (keyname && len + 1 + lstrlenW(keyname) < ARRAY_SIZE(path))
+    {
+        path[len] = '\\';
+        lstrcpyW(path + len + 1, keyname);
+        if (!open_classes_key(HKEY_CLASSES_ROOT, path, access, subkey))
+            return S_OK;
+        path[len] = 0;
+    }
+
     res = open_classes_key(HKEY_CLASSES_ROOT, path, access, &key);
     if (res == ERROR_FILE_NOT_FOUND)
         return REGDB_E_CLASSNOTREG;
@@ -3018,7 +3037,7 @@ HRESULT WINAPI CoRegisterClassObject(REFCLSID rclsid, IUnknown *object, DWORD cl
     IUnknown_AddRef(newclass->object);
 
     EnterCriticalSection(&registered_classes_cs);
-    list_add_tail(&registered_classes, &newclass->entry);
+    list_add_tail(get_registered_classes_bucket(rclsid), &newclass->entry);
     LeaveCriticalSection(&registered_classes_cs);
 
     *cookie = newclass->cookie;
@@ -3057,13 +3076,17 @@ static void com_revoke_class_object(struct registered_class *entry)
 static void com_revoke_local_servers(void)
 {
     struct registered_class *cur, *cur2;
+    unsigned int i;
 
     EnterCriticalSection(&registered_classes_cs);
 
-    LIST_FOR_EACH_ENTRY_SAFE(cur, cur2, &registered_classes, struct registered_class, entry)
+    for (i = 0; i < ARRAY_SIZE(registered_classes); i++)
     {
-        if (cur->clscontext & CLSCTX_LOCAL_SERVER)
-            com_revoke_class_object(cur);
+        LIST_FOR_EACH_ENTRY_SAFE(cur, cur2, &registered_classes[i], struct registered_class, entry)
+        {
+            if (cur->clscontext & CLSCTX_LOCAL_SERVER)
+                com_revoke_class_object(cur);
+        }
     }
 
     LeaveCriticalSection(&registered_classes_cs);
@@ -3072,18 +3095,36 @@ static void com_revoke_local_servers(void)
 void apartment_revoke_all_classes(const struct apartment *apt)
 {
     struct registered_class *cur, *cur2;
+    unsigned int i;
 
     EnterCriticalSection(&registered_classes_cs);
 
-    LIST_FOR_EACH_ENTRY_SAFE(cur, cur2, &registered_classes, struct registered_class, entry)
+    for (i = 0; i < ARRAY_SIZE(registered_classes); i++)
     {
-        if (cur->apartment_id == apt->oxid)
-            com_revoke_class_object(cur);
+        LIST_FOR_EACH_ENTRY_SAFE(cur, cur2, &registered_classes[i], struct registered_class, entry)
+        {
+            if (cur->apartment_id == apt->oxid)
+                com_revoke_class_object(cur);
+        }
     }
 
     LeaveCriticalSection(&registered_classes_cs);
 }
 
+/* must be called with registered_classes_cs held */
+static struct registered_class *find_registered_class_by_cookie(DWORD cookie)
+{
+    struct registered_class *cur;
+    unsigned int i;
+
+    for (i = 0; i < ARRAY_SIZE(registered_classes); i++)
+    {
+        LIST_FOR_EACH_ENTRY(cur, &registered_classes[i], struct registered_class, entry)
+            if (cur->cookie == cookie) return cur;
+    }
+    return NULL;
+}
+
 /***********************************************************************
  *           CoRevokeClassObject    (combase.@)
  */
@@ -3103,11 +3144,8 @@ HRESULT WINAPI DECLSPEC_HOTPATCH CoRevokeClassObject(DWORD cookie)
 
     EnterCriticalSection(&registered_classes_cs);
 
-    LIST_FOR_EACH_ENTRY(cur, &registered_classes, struct registered_class, entry)
+    if ((cur = find_registered_class_by_cookie(cookie)))
     {
-        if (cur->cookie != cookie)
-            continue;
-
         if (cur->apartment_id == apt->oxid)
         {
             com_revoke_class_object(cur);
@@ -3118,8 +3156,6 @@ HRESULT WINAPI DECLSPEC_HOTPATCH CoRevokeClassObject(DWORD cookie)
             ERR("called from wrong apartment, should be called from %s\n", wine_dbgstr_longlong(cur->apartment_id));
             hr = RPC_E_WRONG_THREAD;
         }
-
-        break;
     }
 
     LeaveCriticalSection(&registered_classes_cs);
@@ -3369,8 +3405,14 @@ BOOL WINAPI DllMain(HINSTANCE hinstDLL, DWORD reason, LPVOID reserved)
     switch (reason)
     {
     case DLL_PROCESS_ATTACH:
+    {
+        unsigned int i;
+
         hProxyDll = hinstDLL;
+        for (i = 0; i < ARRAY_SIZE(registered_classes); i++)
+            list_init(&registered_classes[i]);
         break;
+    }
     case DLL_PROCESS_DETACH:
         com_revoke_local_servers();
         if (reserved) break;
@@ -2946,15 +2946,18 @@ static unsigned dwarf2_cache_cuhead(struct module *module, struct dwarf2_module_
 
 static dwarf2_parse_context_t* dwarf2_locate_cu(dwarf2_parse_module_context_t* module_ctx, ULONG_PTR ref)
 {
-    unsigned i;
+    unsigned min = 0, max = module_ctx->unit_contexts.num_elts, pos;
     dwarf2_parse_context_t* ctx;
-    const BYTE* where;
-    for (i = 0; i < module_ctx->unit_contexts.num_elts; ++i)
+    const BYTE* where = module_ctx->sections[section_debug].address + ref;
+
+    /* units are stored in the order of their position inside the section */
+    while (min < max)
     {
-        ctx = *(dwarf2_parse_context_t**)vector_at(&module_ctx->unit_contexts, i);
-        where = module_ctx->sections[ctx->section].address + ref;
-        if (where >= ctx->traverse_DIE.data && where < ctx->traverse_DIE.end_data)
-            return ctx;
+        pos = (min + max) / 2;
+        ctx = *(dwarf2_parse_context_t**)vector_at(&module_ctx->unit_contexts, pos);
+        if (where < ctx->traverse_DIE.data) max = pos;
+        else if (where >= ctx->traverse_DIE.end_data) min = pos + 1;
+        else return ctx;
     }
     FIXME("Couldn't find ref 0x%Ix inside sect\n", ref);
     return NULL;
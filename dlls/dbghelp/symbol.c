@@ -951,13 +951,11 @@ static BOOL symt_enum_module(struct module_pair* pair, const WCHAR* match,
     return FALSE;
 }
 
-static inline unsigned where_to_insert(struct module* module, unsigned high, const struct symt_ht* elt)
+static inline unsigned where_to_insert(struct module* module, unsigned high, ULONG64 addr)
 {
     unsigned    low = 0, mid = high / 2;
-    ULONG64     addr;
 
     if (!high) return 0;
-    symt_get_address(&elt->symt, &addr);
     do
     {
         switch (cmp_sorttab_addr(module, mid, addr))
@@ -971,6 +969,19 @@ static inline unsigned where_to_insert(struct module* module, unsigned high, con
     return mid;
 }
 
+struct sorttab_entry
+{
+    ULONG64             addr;
+    struct symt_ht*     sym;
+};
+
+static int __cdecl sorttab_entry_cmp(const void* p1, const void* p2)
+{
+    const struct sorttab_entry* e1 = p1;
+    const struct sorttab_entry* e2 = p2;
+    return cmp_addr(e1->addr, e2->addr);
+}
+
 /***********************************************************************
  *              resort_symbols
  *
@@ -978,50 +989,51 @@ static inline unsigned where_to_insert(struct module* module, unsigned high, con
  */
 static BOOL resort_symbols(struct module* module)
 {
-    int delta;
+    static struct sorttab_entry* tmp;
+    static unsigned num_tmp;
+    int     delta, i, ins_idx, prev_ins_idx;
 
     if (!(module->module.NumSyms = module->num_symbols))
         return FALSE;
 
-    /* we know that set from 0 up to num_sorttab is already sorted
-     * so sort the remaining (new) symbols, and merge the two sets
-     * (unless the first set is empty)
-     */
     delta = module->num_symbols - module->num_sorttab;
-    qsort(&module->addr_sorttab[module->num_sorttab], delta, sizeof(struct symt_ht*), symt_cmp_addr);
-    if (module->num_sorttab)
+    if (num_tmp < delta)
     {
-        int     i, ins_idx = module->num_sorttab, prev_ins_idx;
-        static struct symt_ht** tmp;
-        static unsigned num_tmp;
-
-        if (num_tmp < delta)
+        struct sorttab_entry* new;
+        if (tmp)
+            new = HeapReAlloc(GetProcessHeap(), 0, tmp, delta * sizeof(*tmp));
+        else
+            new = HeapAlloc(GetProcessHeap(), 0, delta * sizeof(*tmp));
+        if (!new)
         {
-            static struct symt_ht** new;
-            if (tmp)
-                new = HeapReAlloc(GetProcessHeap(), 0, tmp, delta * sizeof(struct symt_ht*));
-            else
-                new = HeapAlloc(GetProcessHeap(), 0, delta * sizeof(struct symt_ht*));
-            if (!new)
-            {
-                module->num_sorttab = 0;
-                return resort_symbols(module);
-            }
-            tmp = new;
-            num_tmp = delta;
+            qsort(module->addr_sorttab, module->num_symbols, sizeof(struct symt_ht*), symt_cmp_addr);
+            module->num_sorttab = module->num_symbols;
+            return module->sortlist_valid = TRUE;
         }
-        memcpy(tmp, &module->addr_sorttab[module->num_sorttab], delta * sizeof(struct symt_ht*));
-        qsort(tmp, delta, sizeof(struct symt_ht*), symt_cmp_addr);
+        tmp = new;
+        num_tmp = delta;
+    }
 
-        for (i = delta - 1; i >= 0; i--)
-        {
-            prev_ins_idx = ins_idx;
-            ins_idx = where_to_insert(module, ins_idx, tmp[i]);
-            memmove(&module->addr_sorttab[ins_idx + i + 1],
-                    &module->addr_sorttab[ins_idx],
-                    (prev_ins_idx - ins_idx) * sizeof(struct symt_ht*));
-            module->addr_sorttab[ins_idx + i] = tmp[i];
-        }
+    /* we know that set from 0 up to num_sorttab is already sorted
+     * so sort the remaining (new) symbols, and merge the two sets
+     * the addresses of the new symbols are only computed once
+     */
+    for (i = 0; i < delta; i++)
+    {
+        tmp[i].sym = module->addr_sorttab[module->num_sorttab + i];
+        symt_get_address(&tmp[i].sym->symt, &tmp[i].addr);
+    }
+    qsort(tmp, delta, sizeof(*tmp), sorttab_entry_cmp);
+
+    ins_idx = module->num_sorttab;
+    for (i = delta - 1; i >= 0; i--)
+    {
+        prev_ins_idx = ins_idx;
+        ins_idx = where_to_insert(module, ins_idx, tmp[i].addr);
+        memmove(&module->addr_sorttab[ins_idx + i + 1],
+                &module->addr_sorttab[ins_idx],
+                (prev_ins_idx - ins_idx) * sizeof(struct symt_ht*));
+        module->addr_sorttab[ins_idx + i] = tmp[i].sym;
     }
     module->num_sorttab = module->num_symbols;
     return module->sortlist_valid = TRUE;
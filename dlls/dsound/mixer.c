@@ -313,6 +313,24 @@ static UINT cp_fields_noresample(IDirectSoundBufferImpl *dsb, UINT count)
     return count;
 }
 
+/* Use independent partial sums, so that the additions don't depend on each
+ * other and the compiler can keep them in vector registers. */
+static inline float fir_dot(const float *coefs, const float *input, int len)
+{
+    float sum0 = 0.0f, sum1 = 0.0f, sum2 = 0.0f, sum3 = 0.0f;
+    int j;
+
+    for (j = 0; j + 4 <= len; j += 4) {
+        sum0 += coefs[j] * input[j];
+        sum1 += coefs[j + 1] * input[j + 1];
+        sum2 += coefs[j + 2] * input[j + 2];
+        sum3 += coefs[j + 3] * input[j + 3];
+    }
+    for (; j < len; j++)
+        sum0 += coefs[j] * input[j];
+    return (sum0 + sum1) + (sum2 + sum3);
+}
+
 static UINT cp_fields_resample(IDirectSoundBufferImpl *dsb, UINT count, LONG64 *freqAccNum)
 {
     UINT i, channel;
@@ -375,23 +393,20 @@ static UINT cp_fields_resample(IDirectSoundBufferImpl *dsb, UINT count, LONG64 *
         UINT ipos = int_fir_steps / dsbfirstep;
 
         UINT idx = (ipos + 1) * dsbfirstep - int_fir_steps - 1;
-        float rem = int_fir_steps + 1.0 - total_fir_steps;
+        float rem = int_fir_steps + 1.0f - total_fir_steps;
+        float rem_inv = 1.0f - rem;
 
         int fir_used = 0;
         while (idx < fir_len - 1) {
-            fir_copy[fir_used++] = fir[idx] * (1.0 - rem) + fir[idx + 1] * rem;
-            idx += dsb->firstep;
+            fir_copy[fir_used++] = fir[idx] * rem_inv + fir[idx + 1] * rem;
+            idx += dsbfirstep;
         }
 
         assert(fir_used <= fir_cachesize);
         assert(ipos + fir_used <= required_input);
 
-        for (channel = 0; channel < dsb->mix_channels; channel++) {
-            int j;
-            float sum = 0.0;
-            float* cache = &intermediate[channel * required_input + ipos];
-            for (j = 0; j < fir_used; j++)
-                sum += fir_copy[j] * cache[j];
+        for (channel = 0; channel < channels; channel++) {
+            float sum = fir_dot(fir_copy, &intermediate[channel * required_input + ipos], fir_used);
             dsb->put(dsb, i * ostride, channel, sum * dsb->firgain);
         }
     }
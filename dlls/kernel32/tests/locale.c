@@ -3844,6 +3844,61 @@ static void test_unicode_sorting(void)
     ok(ret1 == ret2, "Got ret1=%d, ret2=%d\n", ret1, ret2);
 }
 
+static int compare_sortkeys(const WCHAR *locale, DWORD flags, const WCHAR *str1, const WCHAR *str2)
+{
+    BYTE key1[256], key2[256];
+    int len1, len2, ret;
+
+    len1 = pLCMapStringEx(locale, LCMAP_SORTKEY | flags, str1, -1, (WCHAR *)key1, sizeof(key1), NULL, NULL, 0);
+    len2 = pLCMapStringEx(locale, LCMAP_SORTKEY | flags, str2, -1, (WCHAR *)key2, sizeof(key2), NULL, NULL, 0);
+    ret = memcmp(key1, key2, min(len1, len2));
+    if (!ret) ret = len1 - len2;
+    if (ret < 0) return CSTR_LESS_THAN;
+    if (ret > 0) return CSTR_GREATER_THAN;
+    return CSTR_EQUAL;
+}
+
+static void test_CompareString_sortkey(void)
+{
+    static const WCHAR chars[] = L"09aAbBeEzZ \xe9\xc9\xdf";
+    static const DWORD flags[] = { 0, NORM_IGNORECASE, NORM_IGNORENONSPACE, NORM_IGNORESYMBOLS };
+    WCHAR strings[ARRAY_SIZE(chars) * ARRAY_SIZE(chars)][3];
+    int i, j, k, count = 0, ret, expect;
+
+    if (!pCompareStringEx || !pLCMapStringEx)
+    {
+        win_skip("CompareStringEx or LCMapStringEx not available\n");
+        return;
+    }
+
+    /* all strings of one and two characters */
+    for (i = 0; i < ARRAY_SIZE(chars) - 1; i++)
+    {
+        strings[count][0] = chars[i];
+        strings[count++][1] = 0;
+        for (j = 0; j < ARRAY_SIZE(chars) - 1; j++)
+        {
+            strings[count][0] = chars[i];
+            strings[count][1] = chars[j];
+            strings[count++][2] = 0;
+        }
+    }
+
+    for (k = 0; k < ARRAY_SIZE(flags); k++)
+    {
+        for (i = 0; i < count; i++)
+        {
+            for (j = 0; j < count; j++)
+            {
+                expect = compare_sortkeys(L"en-US", flags[k], strings[i], strings[j]);
+                ret = pCompareStringEx(L"en-US", flags[k], strings[i], -1, strings[j], -1, NULL, NULL, 0);
+                ok(ret == expect, "%#lx: %s vs %s got %d, expected %d\n", flags[k],
+                   wine_dbgstr_w(strings[i]), wine_dbgstr_w(strings[j]), ret, expect);
+            }
+        }
+    }
+}
+
 static void test_FoldStringA(void)
 {
   int ret, i, j;
@@ -8741,6 +8796,7 @@ START_TEST(locale)
   test_geo_name();
   test_sorting();
   test_unicode_sorting();
+  test_CompareString_sortkey();
   test_EnumCalendarInfoA();
   test_EnumCalendarInfoW();
   test_EnumCalendarInfoExA();
@@ -512,6 +512,9 @@ static BOOL copy_file( const WCHAR *source, const WCHAR *dest, COPYFILE2_EXTENDE
     static const int buffer_size = 65536;
     HANDLE h1, h2;
     FILE_BASIC_INFORMATION info;
+    FILE_STANDARD_INFORMATION std_info;
+    FILE_END_OF_FILE_INFORMATION eof;
+    DUPLICATE_EXTENTS_DATA extents;
     IO_STATUS_BLOCK io;
     DWORD count;
     BOOL ret = FALSE;
@@ -586,6 +589,25 @@ static BOOL copy_file( const WCHAR *source, const WCHAR *dest, COPYFILE2_EXTENDE
         return FALSE;
     }
 
+    /* let the file system copy the data directly if it can; this skips the progress
+     * and cancel callbacks, so only do it when there are none */
+    if (!progress && !cancel_ptr &&
+        !NtQueryInformationFile( h1, &io, &std_info, sizeof(std_info), FileStandardInformation ))
+    {
+        eof.EndOfFile = std_info.EndOfFile;
+        extents.FileHandle = h1;
+        extents.SourceFileOffset.QuadPart = 0;
+        extents.TargetFileOffset.QuadPart = 0;
+        extents.ByteCount = std_info.EndOfFile;
+        if (!NtSetInformationFile( h2, &io, &eof, sizeof(eof), FileEndOfFileInformation ) &&
+            !NtFsControlFile( h2, NULL, NULL, NULL, &io, FSCTL_DUPLICATE_EXTENTS_TO_FILE,
+                              &extents, sizeof(extents), NULL, 0 ))
+        {
+            ret = TRUE;
+            goto done;
+        }
+    }
+
     while (ReadFile( h1, buffer, buffer_size, &count, NULL ) && count)
     {
         char *p = buffer;
@@ -628,14 +650,12 @@ BOOL WINAPI CopyFileExW( const WCHAR *source, const WCHAR *dest, LPPROGRESS_ROUT
 
     if (progress)
         FIXME("LPPROGRESS_ROUTINE is not supported\n");
-    if (cancel_ptr)
-        FIXME("cancel_ptr is not supported\n");
 
     params.dwSize = sizeof(params);
     params.dwCopyFlags = flags;
     params.pProgressRoutine = NULL;
     params.pvCallbackContext = NULL;
-    params.pfCancel = NULL;
+    params.pfCancel = cancel_ptr;
 
     return copy_file( source, dest, &params );
 }
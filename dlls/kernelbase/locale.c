@@ -3826,6 +3826,56 @@ static int get_sortkey( const struct sortguid *sortid, DWORD flags,
 }
 
 
+/* check whether the character only adds a script and primary weight to the primary key */
+static BOOL has_simple_primary_weight( union char_weights weights, DWORD flags )
+{
+    if (weights._case & CASE_COMPR_6) return FALSE;
+    if (weights.script >= SCRIPT_SYMBOL_1 && weights.script <= SCRIPT_SYMBOL_6)
+        return !(flags & NORM_IGNORESYMBOLS);
+    if (weights.script == SCRIPT_DIGIT) return !(flags & SORT_DIGITSASNUMBERS);
+    return weights.script > SCRIPT_DIGIT && weights.script < SCRIPT_PUA_FIRST;
+}
+
+/* compare the primary weights as long as both strings only contain simple characters,
+ * return FALSE if the full comparison is needed */
+static BOOL compare_primary_weights( DWORD flags, BYTE case_mask, UINT except,
+                                     const WCHAR *src1, int srclen1, const WCHAR *src2, int srclen2,
+                                     int *ret )
+{
+    union char_weights weights1, weights2;
+    int pos, len = min( srclen1, srclen2 );
+    BOOL same_weights = TRUE;
+
+    for (pos = 0; pos < len; pos++)
+    {
+        weights1 = get_char_weights( src1[pos], except );
+        if (!has_simple_primary_weight( weights1, flags )) return FALSE;
+        weights2 = get_char_weights( src2[pos], except );
+        if (!has_simple_primary_weight( weights2, flags )) return FALSE;
+        if ((*ret = weights1.script - weights2.script)) return TRUE;
+        if ((*ret = weights1.primary - weights2.primary)) return TRUE;
+        weights1._case &= case_mask;
+        weights2._case &= case_mask;
+        if (weights1.val != weights2.val) same_weights = FALSE;
+    }
+    if (srclen1 == srclen2)
+    {
+        /* equal primary weights, the secondary weights decide unless they are all equal too */
+        *ret = 0;
+        return same_weights;
+    }
+    /* the longer string has more primary weights if its next character is simple */
+    if (srclen1 > len)
+    {
+        weights1 = get_char_weights( src1[len], except );
+        *ret = 1;
+        return has_simple_primary_weight( weights1, flags );
+    }
+    weights2 = get_char_weights( src2[len], except );
+    *ret = -1;
+    return has_simple_primary_weight( weights2, flags );
+}
+
 /* implementation of CompareStringEx */
 static int compare_string( const struct sortguid *sortid, DWORD flags,
                            const WCHAR *src1, int srclen1, const WCHAR *src2, int srclen2 )
@@ -3846,6 +3896,8 @@ static int compare_string( const struct sortguid *sortid, DWORD flags,
     if (flags & NORM_IGNOREKANATYPE) case_mask &= ~CASE_KATAKANA;
     if ((flags & NORM_LINGUISTIC_CASING) && except && sortid->ling_except) except = sortid->ling_except;
 
+    if (compare_primary_weights( flags, case_mask, except, src1, srclen1, src2, srclen2, &ret )) return ret;
+
     init_sortkey_state( &s1, flags, srclen1, primary1, sizeof(primary1) );
     init_sortkey_state( &s2, flags, srclen2, primary2, sizeof(primary2) );
 
@@ -155,6 +155,8 @@ typedef struct {
     HANDLE *shutdown_events;
     CRITICAL_SECTION cs;
     struct list scheduled_chores;
+    struct list scheduled_tasks;
+    TP_WORK *work;
 } ThreadScheduler;
 extern const vtable_ptr ThreadScheduler_vtable;
 
@@ -1418,6 +1420,11 @@ static void ThreadScheduler_dtor(ThreadScheduler *this)
     LIST_FOR_EACH_ENTRY_SAFE(sc, next, &this->scheduled_chores,
             struct scheduled_chore, entry)
         operator_delete(sc);
+
+    if (!list_empty(&this->scheduled_tasks))
+        ERR("scheduled task list is not empty\n");
+    if (this->work)
+        CloseThreadpoolWork(this->work);
 }
 
 DEFINE_THISCALL_WRAPPER(ThreadScheduler_Id, 4)
@@ -1529,6 +1536,7 @@ DEFINE_THISCALL_WRAPPER(ThreadScheduler_CreateScheduleGroup, 4)
 
 typedef struct
 {
+    struct list entry;
     void (__cdecl *proc)(void*);
     void *data;
     ThreadScheduler *scheduler;
@@ -1536,13 +1544,24 @@ typedef struct
 
 void __cdecl CurrentScheduler_Detach(void);
 
+/* the work object is submitted once per task, each callback runs the oldest queued task */
 static void WINAPI schedule_task_proc(PTP_CALLBACK_INSTANCE instance, void *context, PTP_WORK work)
 {
+    ThreadScheduler *scheduler = context;
     schedule_task_arg arg;
+    struct list *entry;
     BOOL detach = FALSE;
 
-    arg = *(schedule_task_arg*)context;
-    operator_delete(context);
+    EnterCriticalSection(&scheduler->cs);
+    entry = list_head(&scheduler->scheduled_tasks);
+    if (entry)
+        list_remove(entry);
+    LeaveCriticalSection(&scheduler->cs);
+    if (!entry)
+        return;
+
+    arg = *LIST_ENTRY(entry, schedule_task_arg, entry);
+    operator_delete(LIST_ENTRY(entry, schedule_task_arg, entry));
 
     if(&arg.scheduler->scheduler != get_current_scheduler()) {
         ThreadScheduler_Attach(arg.scheduler);
@@ -1569,24 +1588,29 @@ void __thiscall ThreadScheduler_ScheduleTask_loc(ThreadScheduler *this,
     else
         TRACE("(%p %p %p %p) semi-stub\n", this, proc, data, placement);
 
+    if(!this->work) {
+        work = CreateThreadpoolWork(schedule_task_proc, this, NULL);
+        if(!work) {
+            scheduler_resource_allocation_error e;
+
+            scheduler_resource_allocation_error_ctor_name(&e, NULL,
+                    HRESULT_FROM_WIN32(GetLastError()));
+            _CxxThrowException(&e, &scheduler_resource_allocation_error_exception_type);
+        }
+        if(InterlockedCompareExchangePointer((void**)&this->work, work, NULL))
+            CloseThreadpoolWork(work);
+    }
+
     arg = operator_new(sizeof(*arg));
     arg->proc = proc;
     arg->data = data;
     arg->scheduler = this;
     ThreadScheduler_Reference(this);
 
-    work = CreateThreadpoolWork(schedule_task_proc, arg, NULL);
-    if(!work) {
-        scheduler_resource_allocation_error e;
-
-        ThreadScheduler_Release(this);
-        operator_delete(arg);
-        scheduler_resource_allocation_error_ctor_name(&e, NULL,
-                HRESULT_FROM_WIN32(GetLastError()));
-        _CxxThrowException(&e, &scheduler_resource_allocation_error_exception_type);
-    }
-    SubmitThreadpoolWork(work);
-    CloseThreadpoolWork(work);
+    EnterCriticalSection(&this->cs);
+    list_add_tail(&this->scheduled_tasks, &arg->entry);
+    LeaveCriticalSection(&this->cs);
+    SubmitThreadpoolWork(this->work);
 }
 
 DEFINE_THISCALL_WRAPPER(ThreadScheduler_ScheduleTask, 12)
@@ -1649,6 +1673,8 @@ static ThreadScheduler* ThreadScheduler_ctor(ThreadScheduler *this,
     this->cs.DebugInfo->Spare[0] = (DWORD_PTR)(__FILE__ ": ThreadScheduler");
 
     list_init(&this->scheduled_chores);
+    list_init(&this->scheduled_tasks);
+    this->work = NULL;
     return this;
 }
 
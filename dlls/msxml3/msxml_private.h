@@ -242,6 +242,9 @@ extern HRESULT dom_pi_put_xml_decl(IXMLDOMNode *node, BSTR data);
 #include <libxslt/documents.h>
 extern xmlDocPtr xslt_doc_default_loader(const xmlChar *uri, xmlDictPtr dict, int options,
     void *_ctxt, xsltLoadType type);
+extern xsltStylesheetPtr node_compile_stylesheet(const xmlnode*);
+extern HRESULT node_transform_stylesheet(const xmlnode*,xsltStylesheetPtr,BSTR*,ISequentialStream*,
+    const struct xslprocessor_params*);
 
 static inline BSTR bstr_from_xmlChar(const xmlChar *str)
 {
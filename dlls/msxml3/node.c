@@ -1477,23 +1477,26 @@ failed:
     return doc;
 }
 
-HRESULT node_transform_node_params(const xmlnode *This, IXMLDOMNode *stylesheet, BSTR *p,
-    ISequentialStream *stream, const struct xslprocessor_params *params)
+xsltStylesheetPtr node_compile_stylesheet(const xmlnode *sheet)
 {
     xsltStylesheetPtr xsltSS;
     xmlDocPtr sheet_doc;
-    HRESULT hr = S_OK;
-    xmlnode *sheet;
 
-    if (!stylesheet || (!p && !stream)) return E_INVALIDARG;
+    sheet_doc = xmlCopyDoc(sheet->node->doc, 1);
+    xsltSS = xsltParseStylesheetDoc(sheet_doc);
+    if (!xsltSS)
+        xmlFreeDoc(sheet_doc);
 
-    if (p) *p = NULL;
+    return xsltSS;
+}
 
-    sheet = get_node_obj(stylesheet);
-    if(!sheet) return E_FAIL;
+HRESULT node_transform_stylesheet(const xmlnode *This, xsltStylesheetPtr xsltSS, BSTR *p,
+    ISequentialStream *stream, const struct xslprocessor_params *params)
+{
+    HRESULT hr = S_OK;
+
+    if (p) *p = NULL;
 
-    sheet_doc = xmlCopyDoc(sheet->node->doc, 1);
-    xsltSS = xsltParseStylesheetDoc(sheet_doc);
     if (xsltSS)
     {
         const char **xslparams = NULL;
@@ -1539,17 +1542,34 @@ HRESULT node_transform_node_params(const xmlnode *This, IXMLDOMNode *stylesheet,
                 hr = node_transform_write_to_bstr(xsltSS, result, p);
             xmlFreeDoc(result);
         }
-
-        xsltFreeStylesheet(xsltSS);
     }
-    else
-        xmlFreeDoc(sheet_doc);
 
     if (p && !*p) *p = SysAllocStringLen(NULL, 0);
 
     return hr;
 }
 
+HRESULT node_transform_node_params(const xmlnode *This, IXMLDOMNode *stylesheet, BSTR *p,
+    ISequentialStream *stream, const struct xslprocessor_params *params)
+{
+    xsltStylesheetPtr xsltSS;
+    xmlnode *sheet;
+    HRESULT hr;
+
+    if (!stylesheet || (!p && !stream)) return E_INVALIDARG;
+
+    if (p) *p = NULL;
+
+    sheet = get_node_obj(stylesheet);
+    if(!sheet) return E_FAIL;
+
+    xsltSS = node_compile_stylesheet(sheet);
+    hr = node_transform_stylesheet(This, xsltSS, p, stream, params);
+    if (xsltSS) xsltFreeStylesheet(xsltSS);
+
+    return hr;
+}
+
 HRESULT node_transform_node(const xmlnode *node, IXMLDOMNode *stylesheet, BSTR *p)
 {
     return node_transform_node_params(node, stylesheet, p, NULL, NULL);
@@ -46,6 +46,7 @@ typedef struct
     LONG ref;
 
     IXMLDOMNode *node;
+    xsltStylesheetPtr compiled; /* shared by all processors created from this template */
 } xsltemplate;
 
 enum output_type
@@ -101,9 +102,18 @@ static void xslprocessor_par_free(struct xslprocessor_params *params, struct xsl
 
 static void xsltemplate_set_node( xsltemplate *This, IXMLDOMNode *node )
 {
+    xmlnode *sheet;
+
     if (This->node) IXMLDOMNode_Release(This->node);
+    if (This->compiled) xsltFreeStylesheet(This->compiled);
     This->node = node;
-    if (node) IXMLDOMNode_AddRef(node);
+    This->compiled = NULL;
+    if (node)
+    {
+        IXMLDOMNode_AddRef(node);
+        if ((sheet = get_node_obj(node)))
+            This->compiled = node_compile_stylesheet(sheet);
+    }
 }
 
 static HRESULT WINAPI xsltemplate_QueryInterface(
@@ -151,7 +161,7 @@ static ULONG WINAPI xsltemplate_Release( IXSLTemplate *iface )
     TRACE("%p, refcount %lu.\n", iface, ref);
     if ( ref == 0 )
     {
-        if (This->node) IXMLDOMNode_Release( This->node );
+        xsltemplate_set_node(This, NULL);
         free( This );
     }
 
@@ -274,6 +284,7 @@ HRESULT XSLTemplate_create(void **ppObj)
     This->IXSLTemplate_iface.lpVtbl = &XSLTemplateVtbl;
     This->ref = 1;
     This->node = NULL;
+    This->compiled = NULL;
     init_dispex(&This->dispex, (IUnknown*)&This->IXSLTemplate_iface, &xsltemplate_dispex);
 
     *ppObj = &This->IXSLTemplate_iface;
@@ -582,8 +593,12 @@ static HRESULT WINAPI xslprocessor_transform(
 
     SysFreeString(This->outstr);
 
-    hr = node_transform_node_params(get_node_obj(This->input), This->stylesheet->node,
-            &This->outstr, stream, &This->params);
+    if (This->stylesheet->compiled)
+        hr = node_transform_stylesheet(get_node_obj(This->input), This->stylesheet->compiled,
+                &This->outstr, stream, &This->params);
+    else
+        hr = node_transform_node_params(get_node_obj(This->input), This->stylesheet->node,
+                &This->outstr, stream, &This->params);
     if (SUCCEEDED(hr))
     {
         IStream *src = (IStream *)stream;
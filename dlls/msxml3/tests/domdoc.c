@@ -9557,6 +9557,101 @@ todo_wine {
     free_bstrs();
 }
 
+static void check_template_output_(unsigned int line, IXSLTemplate *template, IXMLDOMDocument *input,
+        const WCHAR *expected)
+{
+    IXSLProcessor *processor;
+    IXMLDOMDocument *output;
+    VARIANT_BOOL b;
+    HRESULT hr;
+    VARIANT v;
+    BSTR str;
+
+    hr = IXSLTemplate_createProcessor(template, &processor);
+    ok_(__FILE__, line)(hr == S_OK, "Unexpected hr %#lx.\n", hr);
+
+    V_VT(&v) = VT_UNKNOWN;
+    V_UNKNOWN(&v) = (IUnknown *)input;
+    hr = IXSLProcessor_put_input(processor, v);
+    ok_(__FILE__, line)(hr == S_OK, "Unexpected hr %#lx.\n", hr);
+
+    output = create_document(&IID_IXMLDOMDocument);
+    V_VT(&v) = VT_UNKNOWN;
+    V_UNKNOWN(&v) = (IUnknown *)output;
+    hr = IXSLProcessor_put_output(processor, v);
+    ok_(__FILE__, line)(hr == S_OK, "Unexpected hr %#lx.\n", hr);
+
+    b = VARIANT_FALSE;
+    hr = IXSLProcessor_transform(processor, &b);
+    ok_(__FILE__, line)(hr == S_OK, "Unexpected hr %#lx.\n", hr);
+    ok_(__FILE__, line)(b == VARIANT_TRUE, "got %d\n", b);
+
+    hr = IXMLDOMDocument_get_text(output, &str);
+    ok_(__FILE__, line)(hr == S_OK, "Unexpected hr %#lx.\n", hr);
+    ok_(__FILE__, line)(!lstrcmpW(str, expected), "got %s\n", wine_dbgstr_w(str));
+    SysFreeString(str);
+
+    IXMLDOMDocument_Release(output);
+    IXSLProcessor_Release(processor);
+}
+#define check_template_output(a, b, c) check_template_output_(__LINE__, a, b, c)
+
+static void test_xsltemplate_stylesheet_changes(void)
+{
+    IXMLDOMDocument *doc, *input;
+    IXMLDOMElement *elem;
+    IXMLDOMNode *node, *node2;
+    IXSLTemplate *template;
+    VARIANT_BOOL b;
+    HRESULT hr;
+
+    if (!is_clsid_supported(&CLSID_XSLTemplate, &IID_IXSLTemplate)) return;
+    if (!is_clsid_supported(&CLSID_FreeThreadedDOMDocument, &IID_IXMLDOMDocument)) return;
+
+    hr = CoCreateInstance(&CLSID_FreeThreadedDOMDocument, NULL, CLSCTX_INPROC_SERVER, &IID_IXMLDOMDocument, (void **)&doc);
+    ok(hr == S_OK, "Unexpected hr %#lx.\n", hr);
+
+    b = VARIANT_FALSE;
+    hr = IXMLDOMDocument_loadXML(doc, _bstr_("<xsl:stylesheet xmlns:xsl=\"http://www.w3.org/1999/XSL/Transform\" version=\"1.0\">"
+            "<xsl:template match=\"/\"><r>first</r></xsl:template></xsl:stylesheet>"), &b);
+    ok(hr == S_OK, "Unexpected hr %#lx.\n", hr);
+    ok(b == VARIANT_TRUE, "got %d\n", b);
+
+    input = create_document(&IID_IXMLDOMDocument);
+    b = VARIANT_FALSE;
+    hr = IXMLDOMDocument_loadXML(input, _bstr_("<a/>"), &b);
+    ok(hr == S_OK, "Unexpected hr %#lx.\n", hr);
+    ok(b == VARIANT_TRUE, "got %d\n", b);
+
+    template = create_xsltemplate(&IID_IXSLTemplate);
+    hr = IXSLTemplate_putref_stylesheet(template, (IXMLDOMNode *)doc);
+    ok(hr == S_OK, "Unexpected hr %#lx.\n", hr);
+    check_template_output(template, input, L"first");
+
+    /* edit the stylesheet document */
+    hr = IXMLDOMDocument_get_documentElement(doc, &elem);
+    ok(hr == S_OK, "Unexpected hr %#lx.\n", hr);
+    hr = IXMLDOMElement_get_firstChild(elem, &node);
+    ok(hr == S_OK, "Unexpected hr %#lx.\n", hr);
+    hr = IXMLDOMNode_get_firstChild(node, &node2);
+    ok(hr == S_OK, "Unexpected hr %#lx.\n", hr);
+    hr = IXMLDOMNode_put_text(node2, _bstr_("second"));
+    ok(hr == S_OK, "Unexpected hr %#lx.\n", hr);
+    IXMLDOMNode_Release(node2);
+    IXMLDOMNode_Release(node);
+    IXMLDOMElement_Release(elem);
+
+    /* setting it again picks up the changes */
+    hr = IXSLTemplate_putref_stylesheet(template, (IXMLDOMNode *)doc);
+    ok(hr == S_OK, "Unexpected hr %#lx.\n", hr);
+    check_template_output(template, input, L"second");
+
+    IXSLTemplate_Release(template);
+    IXMLDOMDocument_Release(input);
+    IXMLDOMDocument_Release(doc);
+    free_bstrs();
+}
+
 static void test_insertBefore(void)
 {
     IXMLDOMDocument *doc, *doc2, *doc3;
@@ -14358,6 +14453,7 @@ START_TEST(domdoc)
     test_namespaces_as_attributes();
     test_validate_on_parse_values();
     test_xsltemplate();
+    test_xsltemplate_stylesheet_changes();
     test_xsltext();
     test_max_element_depth_values();
 
@@ -5698,6 +5698,71 @@ static void test_ioctl(void)
     CloseHandle(file);
 }
 
+static void test_duplicate_extents(void)
+{
+    static const ULONG size = 65536;
+    DUPLICATE_EXTENTS_DATA extents;
+    IO_STATUS_BLOCK io;
+    char *data, *buffer;
+    HANDLE src, dst;
+    NTSTATUS status;
+    DWORD count;
+    ULONG i;
+    BOOL ret;
+
+    if (!(src = create_temp_file( 0 ))) return;
+    if (!(dst = create_temp_file( 0 )))
+    {
+        CloseHandle( src );
+        return;
+    }
+
+    data = HeapAlloc( GetProcessHeap(), 0, size );
+    buffer = HeapAlloc( GetProcessHeap(), 0, size );
+    for (i = 0; i < size; i++) data[i] = i * 7;
+
+    ret = WriteFile( src, data, size, &count, NULL );
+    ok( ret && count == size, "WriteFile failed %lu\n", GetLastError() );
+    SetFilePointer( dst, size, NULL, FILE_BEGIN );
+    ret = SetEndOfFile( dst );
+    ok( ret, "SetEndOfFile failed %lu\n", GetLastError() );
+
+    extents.FileHandle = src;
+    extents.SourceFileOffset.QuadPart = 0;
+    extents.TargetFileOffset.QuadPart = 0;
+    extents.ByteCount.QuadPart = size;
+    status = pNtFsControlFile( dst, NULL, NULL, NULL, &io, FSCTL_DUPLICATE_EXTENTS_TO_FILE,
+                               &extents, sizeof(extents), NULL, 0 );
+    /* only supported on some file systems */
+    if (status == STATUS_INVALID_DEVICE_REQUEST || status == STATUS_NOT_SUPPORTED)
+    {
+        skip( "FSCTL_DUPLICATE_EXTENTS_TO_FILE not supported\n" );
+        goto done;
+    }
+    ok( !status, "got %#lx\n", status );
+    ok( !io.Status, "got status %#lx\n", io.Status );
+    ok( !io.Information, "got information %Iu\n", io.Information );
+
+    SetFilePointer( dst, 0, NULL, FILE_BEGIN );
+    memset( buffer, 0, size );
+    ret = ReadFile( dst, buffer, size, &count, NULL );
+    ok( ret && count == size, "ReadFile failed %lu, count %lu\n", GetLastError(), count );
+    ok( !memcmp( buffer, data, size ), "got wrong data\n" );
+
+    /* the target range must be inside the file */
+    extents.TargetFileOffset.QuadPart = size / 2;
+    status = pNtFsControlFile( dst, NULL, NULL, NULL, &io, FSCTL_DUPLICATE_EXTENTS_TO_FILE,
+                               &extents, sizeof(extents), NULL, 0 );
+    ok( status == STATUS_INVALID_PARAMETER, "got %#lx\n", status );
+    ok( GetFileSize( dst, NULL ) == size, "got size %lu\n", GetFileSize( dst, NULL ) );
+
+done:
+    HeapFree( GetProcessHeap(), 0, data );
+    HeapFree( GetProcessHeap(), 0, buffer );
+    CloseHandle( src );
+    CloseHandle( dst );
+}
+
 static void test_flush_buffers_file(void)
 {
     char path[MAX_PATH], buffer[MAX_PATH];
@@ -6133,6 +6198,7 @@ START_TEST(file)
     test_query_volume_information_file();
     test_query_attribute_information_file();
     test_ioctl();
+    test_duplicate_extents();
     test_query_ea();
     test_flush_buffers_file();
     test_mailslot_name();
@@ -2022,10 +2022,46 @@ static void test_query_object(void)
     pNtClose( handle );
 }
 
-static void test_type_mismatch(void)
+static void check_read_mismatch( HANDLE h, int line )
+{
+    char buffer[16];
+    DWORD size;
+    BOOL ret;
+    int i;
+
+    /* the second call may use the error cached by the first one */
+    for (i = 0; i < 2; i++)
+    {
+        SetLastError( 0xdeadbeef );
+        ret = ReadFile( h, buffer, sizeof(buffer), &size, NULL );
+        ok_(__FILE__, line)(!ret, "ReadFile succeeded\n");
+        ok_(__FILE__, line)(GetLastError() == ERROR_INVALID_HANDLE, "got error %lu\n", GetLastError());
+    }
+}
+
+static void check_reused_handle( HANDLE old, const char *file_name, int line )
 {
     HANDLE h;
+    DWORD size;
+    BOOL ret;
+
+    h = CreateFileA( file_name, GENERIC_READ | GENERIC_WRITE, 0, NULL, CREATE_ALWAYS,
+                     FILE_FLAG_DELETE_ON_CLOSE, NULL );
+    ok_(__FILE__, line)(h != INVALID_HANDLE_VALUE, "CreateFile failed %lu\n", GetLastError());
+    if (h != old) skip_(__FILE__, line)("handle value %p was not reused\n", old);
+    /* the error cached for the closed handle must not be used for the file */
+    ret = WriteFile( h, "test", 4, &size, NULL );
+    ok_(__FILE__, line)(ret, "WriteFile failed %lu\n", GetLastError());
+    ok_(__FILE__, line)(size == 4, "got size %lu\n", size);
+    CloseHandle( h );
+}
+
+static void test_type_mismatch(void)
+{
+    char tmp_path[MAX_PATH], file_name[MAX_PATH];
+    HANDLE h, dup;
     NTSTATUS res;
+    BOOL ret;
     OBJECT_ATTRIBUTES attr = { .Length = sizeof(attr) };
 
     res = pNtCreateEvent( &h, 0, &attr, NotificationEvent, 0 );
@@ -2034,7 +2070,27 @@ static void test_type_mismatch(void)
     res = pNtReleaseSemaphore( h, 30, NULL );
     ok(res == STATUS_OBJECT_TYPE_MISMATCH, "expected 0xc0000024, got %lx\n", res);
 
+    GetTempPathA( MAX_PATH, tmp_path );
+    GetTempFileNameA( tmp_path, "om", 0, file_name );
+
+    check_read_mismatch( h, __LINE__ );
     pNtClose( h );
+    check_reused_handle( h, file_name, __LINE__ );
+
+    /* same when the handle is closed through DuplicateHandle */
+    res = pNtCreateEvent( &h, EVENT_ALL_ACCESS, &attr, NotificationEvent, 0 );
+    ok(!res, "can't create event: %lx\n", res);
+    check_read_mismatch( h, __LINE__ );
+    ret = DuplicateHandle( GetCurrentProcess(), h, GetCurrentProcess(), &dup, 0, FALSE,
+                           DUPLICATE_SAME_ACCESS | DUPLICATE_CLOSE_SOURCE );
+    ok(ret, "DuplicateHandle failed %lu\n", GetLastError());
+    check_read_mismatch( dup, __LINE__ );
+    check_reused_handle( h, file_name, __LINE__ );
+    pNtClose( dup );
+
+    /* pseudo-handles */
+    check_read_mismatch( GetCurrentProcess(), __LINE__ );
+    check_read_mismatch( GetCurrentThread(), __LINE__ );
 }
 
 static void test_null_device(void)
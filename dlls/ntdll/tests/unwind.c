@@ -3125,6 +3125,7 @@ static void test_dynamic_unwind(void)
 {
     static const int code_offset = 1024;
     char buf[2 * sizeof(RUNTIME_FUNCTION) + 4];
+    static RUNTIME_FUNCTION many_funcs[16];
     MEM_EXTENDED_PARAMETER param = { 0 };
     RUNTIME_FUNCTION *runtime_func, *func;
     ULONG_PTR table, base, ec_code;
@@ -3133,6 +3134,7 @@ static void test_dynamic_unwind(void)
     SIZE_T size = 0x1000;
     DWORD count;
     ULONG len, len2;
+    int i;
 
     if (!pRtlInstallFunctionTableCallback || !pRtlLookupFunctionEntry)
     {
@@ -3335,6 +3337,30 @@ static void test_dynamic_unwind(void)
 
     pRtlDeleteGrowableFunctionTable( growable_table );
 
+    /* Many adjacent tables, registered in reverse address order */
+    for (i = ARRAY_SIZE(many_funcs) - 1; i >= 0; i--)
+    {
+        many_funcs[i].BeginAddress = 0;
+        many_funcs[i].UnwindData   = 0;
+        SET_RUNTIME_FUNC_LEN( &many_funcs[i], 16 );
+        ok( pRtlAddFunctionTable( &many_funcs[i], 1, (ULONG_PTR)code_mem + 32 * i ),
+            "RtlAddFunctionTable failed for table %d\n", i );
+    }
+    for (i = 0; i < ARRAY_SIZE(many_funcs); i++)
+    {
+        base = 0xdeadbeef;
+        func = pRtlLookupFunctionEntry( (ULONG_PTR)code_mem + 32 * i + 8, &base, NULL );
+        ok( func == &many_funcs[i], "%d: RtlLookupFunctionEntry expected func: %p, got: %p\n",
+            i, &many_funcs[i], func );
+        ok( base == (ULONG_PTR)code_mem + 32 * i, "%d: RtlLookupFunctionEntry expected base: %Ix, got: %Ix\n",
+            i, (ULONG_PTR)code_mem + 32 * i, base );
+        func = pRtlLookupFunctionEntry( (ULONG_PTR)code_mem + 32 * i + 24, &base, NULL );
+        ok( func == NULL, "%d: RtlLookupFunctionEntry got %p\n", i, func );
+    }
+
+    for (i = 0; i < ARRAY_SIZE(many_funcs); i++)
+        ok( pRtlDeleteFunctionTable( &many_funcs[i] ), "RtlDeleteFunctionTable failed for table %d\n", i );
+
     param.Type = MemExtendedParameterAttributeFlags;
     param.ULong64 = MEM_EXTENDED_PARAMETER_EC_CODE;
     ec_code = 0;
@@ -2503,6 +2503,98 @@ static void test_NtFreeVirtualMemory(void)
     ok(status == STATUS_SUCCESS, "Unexpected status %08lx.\n", status);
 }
 
+static BOOL set_lock_memory_privilege( BOOL enable )
+{
+    TOKEN_PRIVILEGES privs;
+    NTSTATUS status;
+    HANDLE token;
+
+    if (NtOpenProcessToken( NtCurrentProcess(), TOKEN_ADJUST_PRIVILEGES, &token )) return FALSE;
+    privs.PrivilegeCount = 1;
+    privs.Privileges[0].Luid.LowPart = SE_LOCK_MEMORY_PRIVILEGE;
+    privs.Privileges[0].Luid.HighPart = 0;
+    privs.Privileges[0].Attributes = enable ? SE_PRIVILEGE_ENABLED : 0;
+    status = NtAdjustPrivilegesToken( token, FALSE, &privs, sizeof(privs), NULL, NULL );
+    NtClose( token );
+    return status == STATUS_SUCCESS;
+}
+
+static void test_large_pages(void)
+{
+    const KUSER_SHARED_DATA *user_shared_data = (void *)0x7ffe0000;
+    SIZE_T large_page = user_shared_data->LargePageMinimum, size;
+    MEMORY_BASIC_INFORMATION mbi;
+    NTSTATUS status;
+    void *addr, *base;
+
+    if (!large_page)
+    {
+        skip( "large pages are not supported\n" );
+        return;
+    }
+
+    set_lock_memory_privilege( FALSE );
+    addr = NULL;
+    size = large_page;
+    status = NtAllocateVirtualMemory( NtCurrentProcess(), &addr, 0, &size,
+                                      MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE );
+    ok( status == STATUS_PRIVILEGE_NOT_HELD, "Unexpected status %08lx.\n", status );
+
+    if (!set_lock_memory_privilege( TRUE ))
+    {
+        skip( "SeLockMemoryPrivilege is not available\n" );
+        return;
+    }
+
+    addr = NULL;
+    size = large_page;
+    status = NtAllocateVirtualMemory( NtCurrentProcess(), &addr, 0, &size,
+                                      MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE );
+    if (broken( status == STATUS_NO_MEMORY || status == STATUS_INSUFFICIENT_RESOURCES ))
+    {
+        skip( "no large page available\n" );
+        set_lock_memory_privilege( FALSE );
+        return;
+    }
+    ok( status == STATUS_SUCCESS, "Unexpected status %08lx.\n", status );
+    ok( !((ULONG_PTR)addr & (large_page - 1)), "Unaligned address %p.\n", addr );
+    ok( size == large_page, "Unexpected size %#Ix.\n", size );
+    memset( addr, 0x55, large_page );
+    status = NtQueryVirtualMemory( NtCurrentProcess(), addr, MemoryBasicInformation, &mbi, sizeof(mbi), NULL );
+    ok( status == STATUS_SUCCESS, "Unexpected status %08lx.\n", status );
+    ok( mbi.State == MEM_COMMIT, "Unexpected state %#lx.\n", mbi.State );
+    ok( mbi.Type == MEM_PRIVATE, "Unexpected type %#lx.\n", mbi.Type );
+    ok( mbi.Protect == PAGE_READWRITE, "Unexpected protection %#lx.\n", mbi.Protect );
+    ok( mbi.RegionSize == large_page, "Unexpected size %#Ix.\n", mbi.RegionSize );
+    base = addr;
+    size = 0;
+    status = NtFreeVirtualMemory( NtCurrentProcess(), &addr, &size, MEM_RELEASE );
+    ok( status == STATUS_SUCCESS, "Unexpected status %08lx.\n", status );
+
+    /* the size must be a multiple of the large page size */
+    addr = NULL;
+    size = large_page + page_size;
+    status = NtAllocateVirtualMemory( NtCurrentProcess(), &addr, 0, &size,
+                                      MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE );
+    ok( status == STATUS_INVALID_PARAMETER, "Unexpected status %08lx.\n", status );
+
+    /* so must be the address */
+    addr = (char *)base + page_size;
+    size = large_page;
+    status = NtAllocateVirtualMemory( NtCurrentProcess(), &addr, 0, &size,
+                                      MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE );
+    ok( status == STATUS_INVALID_PARAMETER, "Unexpected status %08lx.\n", status );
+
+    /* large pages can't be reserved without committing them */
+    addr = NULL;
+    size = large_page;
+    status = NtAllocateVirtualMemory( NtCurrentProcess(), &addr, 0, &size,
+                                      MEM_RESERVE | MEM_LARGE_PAGES, PAGE_READWRITE );
+    ok( status == STATUS_INVALID_PARAMETER, "Unexpected status %08lx.\n", status );
+
+    set_lock_memory_privilege( FALSE );
+}
+
 static void test_prefetch(void)
 {
     NTSTATUS status;
@@ -3251,6 +3343,7 @@ START_TEST(virtual)
     test_NtAllocateVirtualMemoryEx();
     test_NtAllocateVirtualMemoryEx_address_requirements();
     test_NtFreeVirtualMemory();
+    test_large_pages();
     test_RtlCreateUserStack();
     test_NtMapViewOfSection();
     test_NtMapViewOfSectionEx();
@@ -84,6 +84,9 @@
 #ifdef HAVE_LINUX_MAJOR_H
 # include <linux/major.h>
 #endif
+#ifdef HAVE_LINUX_FS_H
+# include <linux/fs.h>
+#endif
 #ifdef HAVE_SYS_PARAM_H
 #include <sys/param.h>
 #endif
@@ -6212,6 +6215,100 @@ static void ignore_server_ioctl_struct_holes( ULONG code, const void *in_buffer,
 }
 
 
+/* copy a range of data from one regular file to another without going through user space */
+static NTSTATUS duplicate_extents( HANDLE handle, const DUPLICATE_EXTENTS_DATA *data )
+{
+    int src_fd, dst_fd, src_needs_close, dst_needs_close;
+    enum server_fd_type src_type, dst_type;
+    off_t src_offset = data->SourceFileOffset.QuadPart;
+    off_t dst_offset = data->TargetFileOffset.QuadPart;
+    LONGLONG count = data->ByteCount.QuadPart;
+    struct stat st;
+    NTSTATUS status;
+
+    if (src_offset < 0 || dst_offset < 0 || count < 0) return STATUS_INVALID_PARAMETER;
+
+    if ((status = server_get_unix_fd( data->FileHandle, FILE_READ_DATA, &src_fd,
+                                      &src_needs_close, &src_type, NULL )))
+        return status;
+    if ((status = server_get_unix_fd( handle, FILE_WRITE_DATA, &dst_fd, &dst_needs_close, &dst_type, NULL )))
+    {
+        if (src_needs_close) close( src_fd );
+        return status;
+    }
+
+    status = STATUS_INVALID_DEVICE_REQUEST;
+    if (src_type != FD_TYPE_FILE || dst_type != FD_TYPE_FILE) goto done;
+
+    /* the target range has to be inside the file, the caller extends it first */
+    if (fstat( dst_fd, &st ) == -1)
+    {
+        status = errno_to_status( errno );
+        goto done;
+    }
+    if (dst_offset > st.st_size || count > st.st_size - dst_offset)
+    {
+        status = STATUS_INVALID_PARAMETER;
+        goto done;
+    }
+
+    if (!count)
+    {
+        status = STATUS_SUCCESS;
+        goto done;
+    }
+
+#ifdef FICLONERANGE
+    {
+        /* share the blocks if the file system supports it */
+        struct file_clone_range range;
+
+        range.src_fd = src_fd;
+        range.src_offset = src_offset;
+        range.src_length = count;
+        range.dest_offset = dst_offset;
+        if (!ioctl( dst_fd, FICLONERANGE, &range ))
+        {
+            status = STATUS_SUCCESS;
+            goto done;
+        }
+        TRACE( "FICLONERANGE failed: %s\n", strerror( errno ));
+    }
+#endif
+
+#ifdef HAVE_COPY_FILE_RANGE
+    while (count)
+    {
+        ssize_t ret = copy_file_range( src_fd, &src_offset, dst_fd, &dst_offset, count, 0 );
+
+        if (ret > 0)
+        {
+            count -= ret;
+            status = STATUS_SUCCESS;
+            continue;
+        }
+        if (!ret)
+        {
+            status = STATUS_END_OF_FILE;
+            break;
+        }
+        if (errno == EINTR) continue;
+        /* not supported for these files, let the caller fall back to read and write */
+        if (status == STATUS_INVALID_DEVICE_REQUEST &&
+            (errno == ENOSYS || errno == EXDEV || errno == EINVAL || errno == EOPNOTSUPP))
+            break;
+        status = errno_to_status( errno );
+        break;
+    }
+#endif
+
+done:
+    if (src_needs_close) close( src_fd );
+    if (dst_needs_close) close( dst_fd );
+    return status;
+}
+
+
 /******************************************************************************
  *              NtFsControlFile   (NTDLL.@)
  */
@@ -6314,6 +6411,12 @@ NTSTATUS WINAPI NtFsControlFile( HANDLE handle, HANDLE event, PIO_APC_ROUTINE ap
         TRACE("FSCTL_SET_SPARSE: Ignoring request\n");
         status = STATUS_SUCCESS;
         break;
+
+    case FSCTL_DUPLICATE_EXTENTS_TO_FILE:
+        if (in_size < sizeof(DUPLICATE_EXTENTS_DATA)) status = STATUS_INVALID_PARAMETER;
+        else status = duplicate_extents( handle, in_buffer );
+        break;
+
     default:
         return server_ioctl_file( handle, event, apc, apc_context, io, code,
                                   in_buffer, in_size, out_buffer, out_size );
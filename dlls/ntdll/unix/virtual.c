@@ -199,6 +199,9 @@ static void *working_set_limit   = (void *)0x7fff0000;
 
 static void *host_addr_space_limit;  /* top of the host virtual address space */
 
+static SIZE_T large_page_size = 2 * 1024 * 1024;  /* transparent huge page size */
+static SIZE_T huge_reserve_min;  /* minimum reservation size for huge page advice, 0 to disable */
+
 static struct file_view *arm64ec_view;
 
 ULONG_PTR user_space_wow_limit = 0;
@@ -3627,6 +3630,37 @@ static void *alloc_virtual_heap( SIZE_T size )
     return anon_mmap_alloc( size, PROT_READ | PROT_WRITE );
 }
 
+/***********************************************************************
+ *           init_large_pages
+ */
+static void init_large_pages(void)
+{
+    const char *env;
+#ifdef __linux__
+    FILE *f;
+
+    if ((f = fopen( "/sys/kernel/mm/transparent_hugepage/hpage_pmd_size", "r" )))
+    {
+        unsigned long size;
+        /* Windows only knows about 2M and 4M large pages, don't report anything else */
+        if (fscanf( f, "%lu", &size ) == 1)
+            large_page_size = (size == 2 * 1024 * 1024 || size == 4 * 1024 * 1024) ? size : 0;
+        fclose( f );
+    }
+#endif
+#ifndef MADV_HUGEPAGE
+    large_page_size = 0;
+#endif
+    TRACE( "large page size: %luk\n", (unsigned long)large_page_size / 1024 );
+
+    /* optionally ask for huge pages on big anonymous reservations too */
+    if (large_page_size && (env = getenv( "WINEHUGEPAGES" )) && atoi( env ))
+    {
+        huge_reserve_min = 16 * large_page_size;
+        TRACE( "using huge pages for reservations above %luk\n", (unsigned long)huge_reserve_min / 1024 );
+    }
+}
+
 /***********************************************************************
  *           virtual_init
  */
@@ -3660,6 +3694,8 @@ void virtual_init(void)
 
     if (use_kernel_writewatch) TRACE( "Using kernel write watches.\n" );
 
+    init_large_pages();
+
     if (preload_info && *preload_info)
         for (i = 0; (*preload_info)[i].size; i++)
             mmap_add_reserved_area( (*preload_info)[i].addr, (*preload_info)[i].size );
@@ -4315,7 +4351,7 @@ void virtual_init_user_shared_data(void)
     virtual_get_system_info( &info, FALSE );
 
     data->TickCountMultiplier   = 1 << 24;
-    data->LargePageMinimum      = 2 * 1024 * 1024;
+    data->LargePageMinimum      = large_page_size;
     data->SystemCall            = 1;
     data->NumberOfPhysicalPages = info.MmNumberOfPhysicalPages;
     data->NXSupportPolicy       = NX_SUPPORT_POLICY_OPTIN;
@@ -4909,6 +4945,49 @@ void virtual_set_large_address_space(void)
 }
 
 
+/***********************************************************************
+ *             advise_huge_pages
+ *
+ * Ask the kernel to back the range with transparent huge pages.
+ */
+static void advise_huge_pages( void *base, SIZE_T size )
+{
+#ifdef MADV_HUGEPAGE
+    char *start = ROUND_ADDR( (char *)base + large_page_size - 1, large_page_size - 1 );
+    char *end = ROUND_ADDR( (char *)base + size, large_page_size - 1 );
+
+    if (start < end && madvise( start, end - start, MADV_HUGEPAGE ))
+        WARN( "madvise(MADV_HUGEPAGE) failed for %p-%p, err %s\n", start, end, strerror(errno) );
+#endif
+}
+
+
+/***********************************************************************
+ *             has_lock_memory_privilege
+ *
+ * Check whether the caller is allowed to allocate large pages.
+ */
+static BOOL has_lock_memory_privilege(void)
+{
+    PRIVILEGE_SET privs;
+    BOOLEAN ret = FALSE;
+    HANDLE token;
+
+    if (NtOpenThreadTokenEx( GetCurrentThread(), TOKEN_QUERY, TRUE, 0, &token ) &&
+        NtOpenProcessTokenEx( GetCurrentProcess(), TOKEN_QUERY, 0, &token ))
+        return FALSE;
+
+    privs.PrivilegeCount = 1;
+    privs.Control = PRIVILEGE_SET_ALL_NECESSARY;
+    privs.Privilege[0].Luid.LowPart = SE_LOCK_MEMORY_PRIVILEGE;
+    privs.Privilege[0].Luid.HighPart = 0;
+    privs.Privilege[0].Attributes = 0;
+    NtPrivilegeCheck( token, &privs, &ret );
+    NtClose( token );
+    return ret;
+}
+
+
 /***********************************************************************
  *             allocate_virtual_memory
  *
@@ -4966,6 +5045,17 @@ static NTSTATUS allocate_virtual_memory( void **ret, SIZE_T *size_ptr, ULONG typ
     if (type & MEM_RESERVE_PLACEHOLDER && (protect != PAGE_NOACCESS)) return STATUS_INVALID_PARAMETER;
     if (!arm64ec_view && (attributes & MEM_EXTENDED_PARAMETER_EC_CODE)) return STATUS_INVALID_PARAMETER;
 
+    if (type & MEM_LARGE_PAGES)
+    {
+        /* large pages are reserved and committed at once, on large page boundaries */
+        if (!large_page_size || (type & (MEM_RESERVE | MEM_COMMIT)) != (MEM_RESERVE | MEM_COMMIT) ||
+            (type & (MEM_WRITE_WATCH | MEM_RESERVE_PLACEHOLDER | MEM_REPLACE_PLACEHOLDER)) ||
+            is_dos_memory || (*size_ptr & (large_page_size - 1)) || ((UINT_PTR)*ret & (large_page_size - 1)))
+            return STATUS_INVALID_PARAMETER;
+        if (!has_lock_memory_privilege()) return STATUS_PRIVILEGE_NOT_HELD;
+        if (align < large_page_size) align = large_page_size;
+    }
+
     /* Reserve the memory */
 
     server_enter_uninterrupted_section( &virtual_mutex, &sigset );
@@ -4984,7 +5074,13 @@ static NTSTATUS allocate_virtual_memory( void **ret, SIZE_T *size_ptr, ULONG typ
             else status = map_view( &view, base, size, type, vprot, limit_low, limit_high,
                                     align ? align - 1 : granularity_mask );
 
-            if (status == STATUS_SUCCESS) base = view->base;
+            if (status == STATUS_SUCCESS)
+            {
+                base = view->base;
+                if ((type & MEM_LARGE_PAGES) ||
+                    (huge_reserve_min && size >= huge_reserve_min && !(vprot & VPROT_WRITEWATCH) && !is_dos_memory))
+                    advise_huge_pages( base, size );
+            }
         }
     }
     else if (type & MEM_RESET)
@@ -5039,7 +5135,8 @@ static NTSTATUS allocate_virtual_memory( void **ret, SIZE_T *size_ptr, ULONG typ
 NTSTATUS WINAPI NtAllocateVirtualMemory( HANDLE process, PVOID *ret, ULONG_PTR zero_bits,
                                          SIZE_T *size_ptr, ULONG type, ULONG protect )
 {
-    static const ULONG type_mask = MEM_COMMIT | MEM_RESERVE | MEM_TOP_DOWN | MEM_WRITE_WATCH | MEM_RESET;
+    static const ULONG type_mask = MEM_COMMIT | MEM_RESERVE | MEM_TOP_DOWN | MEM_WRITE_WATCH | MEM_RESET
+                                   | MEM_LARGE_PAGES;
     ULONG_PTR limit;
 
     TRACE("%p %p %08lx %x %08x\n", process, *ret, *size_ptr, type, protect );
@@ -5179,7 +5276,8 @@ NTSTATUS WINAPI NtAllocateVirtualMemoryEx( HANDLE process, PVOID *ret, SIZE_T *s
                                            ULONG count )
 {
     static const ULONG type_mask = MEM_COMMIT | MEM_RESERVE | MEM_TOP_DOWN | MEM_WRITE_WATCH
-                                   | MEM_RESET | MEM_RESERVE_PLACEHOLDER | MEM_REPLACE_PLACEHOLDER;
+                                   | MEM_RESET | MEM_RESERVE_PLACEHOLDER | MEM_REPLACE_PLACEHOLDER
+                                   | MEM_LARGE_PAGES;
     ULONG_PTR limit_low = 0;
     ULONG_PTR limit_high = 0;
     ULONG_PTR align = 0;
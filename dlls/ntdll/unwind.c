@@ -29,7 +29,6 @@
 #include "windef.h"
 #include "winternl.h"
 #include "wine/exception.h"
-#include "wine/list.h"
 #include "ntdll_misc.h"
 #include "unwind.h"
 #include "wine/debug.h"
@@ -59,7 +58,6 @@ extern LONG __C_ExecuteExceptionFilter( EXCEPTION_POINTERS *ptrs, void *frame,
 
 struct dynamic_unwind_entry
 {
-    struct list       entry;
     ULONG_PTR         base;
     ULONG_PTR         end;
     RUNTIME_FUNCTION *table;
@@ -67,45 +65,141 @@ struct dynamic_unwind_entry
     DWORD             max_count;
     PGET_RUNTIME_FUNCTION_CALLBACK callback;
     PVOID             context;
+    ULONG             seq;
+    ULONG_PTR         max_end;  /* largest end in the index subtree rooted at this entry */
 };
 
-static struct list dynamic_unwind_list = LIST_INIT(dynamic_unwind_list);
+/* entries sorted by base address, lookups only need the lock in shared mode.
+ * The array is also used as an implicit balanced tree, the root of the [min,max)
+ * range being at (min + max) / 2, so that the max_end of each subtree can be used
+ * to find overlapping ranges without scanning. */
+static struct dynamic_unwind_entry **dynamic_unwind_index;
+static unsigned int dynamic_unwind_count;
+static unsigned int dynamic_unwind_size;
+static ULONG dynamic_unwind_seq;
+static RTL_SRWLOCK dynamic_unwind_lock = RTL_SRWLOCK_INIT;
 
-static RTL_CRITICAL_SECTION dynamic_unwind_section;
-static RTL_CRITICAL_SECTION_DEBUG dynamic_unwind_debug =
+/* index of the first entry whose base is above pc, lock must be held */
+static unsigned int dynamic_unwind_upper_bound( ULONG_PTR pc )
 {
-    0, 0, &dynamic_unwind_section,
-    { &dynamic_unwind_debug.ProcessLocksList, &dynamic_unwind_debug.ProcessLocksList },
-      0, 0, { (DWORD_PTR)(__FILE__ ": dynamic_unwind_section") }
-};
-static RTL_CRITICAL_SECTION dynamic_unwind_section = { &dynamic_unwind_debug, -1, 0, 0, 0, 0 };
+    unsigned int min = 0, max = dynamic_unwind_count, pos;
 
+    while (min < max)
+    {
+        pos = (min + max) / 2;
+        if (dynamic_unwind_index[pos]->base <= pc) min = pos + 1;
+        else max = pos;
+    }
+    return min;
+}
 
-static RUNTIME_FUNCTION *lookup_dynamic_function_table( ULONG_PTR pc, ULONG_PTR *base, ULONG *count )
+/* recompute the max_end values of the [min,max) subtree, lock must be held exclusively */
+static ULONG_PTR update_dynamic_unwind_max_end( unsigned int min, unsigned int max )
 {
+    unsigned int pos = (min + max) / 2;
     struct dynamic_unwind_entry *entry;
+    ULONG_PTR end, left, right;
+
+    if (min >= max) return 0;
+    entry = dynamic_unwind_index[pos];
+    left = update_dynamic_unwind_max_end( min, pos );
+    right = update_dynamic_unwind_max_end( pos + 1, max );
+    end = max( entry->end, max( left, right ));
+    return entry->max_end = end;
+}
+
+/* find the first registered entry of the [min,max) subtree that contains pc, lock must be held */
+static void find_dynamic_unwind_entry( ULONG_PTR pc, unsigned int min, unsigned int max,
+                                       struct dynamic_unwind_entry **found )
+{
+    struct dynamic_unwind_entry *entry;
+    unsigned int pos;
+
+    while (min < max)
+    {
+        pos = (min + max) / 2;
+        entry = dynamic_unwind_index[pos];
+        if (entry->max_end <= pc) return;  /* nothing in this subtree reaches pc */
+        if (entry->base > pc)
+        {
+            max = pos;
+            continue;
+        }
+        if (pc < entry->end && (!*found || entry->seq < (*found)->seq)) *found = entry;
+        find_dynamic_unwind_entry( pc, min, pos, found );
+        min = pos + 1;
+    }
+}
+
+static BOOL add_dynamic_unwind_entry( struct dynamic_unwind_entry *entry )
+{
+    unsigned int pos;
+    BOOL ret = FALSE;
+
+    RtlAcquireSRWLockExclusive( &dynamic_unwind_lock );
+    if (dynamic_unwind_count == dynamic_unwind_size)
+    {
+        unsigned int new_size = max( 16, dynamic_unwind_size * 2 );
+        struct dynamic_unwind_entry **new_index;
+
+        if (dynamic_unwind_index)
+            new_index = RtlReAllocateHeap( GetProcessHeap(), 0, dynamic_unwind_index, new_size * sizeof(*new_index) );
+        else
+            new_index = RtlAllocateHeap( GetProcessHeap(), 0, new_size * sizeof(*new_index) );
+        if (!new_index) goto done;
+        dynamic_unwind_index = new_index;
+        dynamic_unwind_size = new_size;
+    }
+    entry->seq = dynamic_unwind_seq++;
+    /* entries with the same base stay in registration order */
+    pos = dynamic_unwind_upper_bound( entry->base );
+    memmove( dynamic_unwind_index + pos + 1, dynamic_unwind_index + pos,
+             (dynamic_unwind_count - pos) * sizeof(*dynamic_unwind_index) );
+    dynamic_unwind_index[pos] = entry;
+    dynamic_unwind_count++;
+    update_dynamic_unwind_max_end( 0, dynamic_unwind_count );
+    ret = TRUE;
+done:
+    RtlReleaseSRWLockExclusive( &dynamic_unwind_lock );
+    return ret;
+}
+
+/* lock must be held exclusively */
+static void remove_dynamic_unwind_entry( unsigned int pos )
+{
+    dynamic_unwind_count--;
+    memmove( dynamic_unwind_index + pos, dynamic_unwind_index + pos + 1,
+             (dynamic_unwind_count - pos) * sizeof(*dynamic_unwind_index) );
+    update_dynamic_unwind_max_end( 0, dynamic_unwind_count );
+}
+
+static RUNTIME_FUNCTION *lookup_dynamic_function_table( ULONG_PTR pc, ULONG_PTR *base, ULONG *count )
+{
+    struct dynamic_unwind_entry *found = NULL;
+    PGET_RUNTIME_FUNCTION_CALLBACK callback = NULL;
     RUNTIME_FUNCTION *ret = NULL;
+    void *context = NULL;
 
-    RtlEnterCriticalSection( &dynamic_unwind_section );
-    LIST_FOR_EACH_ENTRY( entry, &dynamic_unwind_list, struct dynamic_unwind_entry, entry )
+    RtlAcquireSRWLockShared( &dynamic_unwind_lock );
+    /* ranges may overlap, the first registered one that contains pc wins */
+    find_dynamic_unwind_entry( pc, 0, dynamic_unwind_count, &found );
+    if (found)
     {
-        if (pc >= entry->base && pc < entry->end)
+        *base = found->base;
+        if ((callback = found->callback)) context = found->context;
+        else
         {
-            *base = entry->base;
-            if (entry->callback)
-            {
-                ret = entry->callback( pc, entry->context );
-                *count = 1;
-            }
-            else
-            {
-                ret = entry->table;
-                *count = entry->count;
-            }
-            break;
+            ret = found->table;
+            *count = found->count;
         }
     }
-    RtlLeaveCriticalSection( &dynamic_unwind_section );
+    RtlReleaseSRWLockShared( &dynamic_unwind_lock );
+
+    if (callback)
+    {
+        ret = callback( pc, context );
+        *count = 1;
+    }
     return ret;
 }
 
@@ -139,10 +233,11 @@ BOOLEAN CDECL RtlInstallFunctionTableCallback( ULONG_PTR table, ULONG_PTR base,
     entry->callback  = callback;
     entry->context   = context;
 
-    RtlEnterCriticalSection( &dynamic_unwind_section );
-    list_add_tail( &dynamic_unwind_list, &entry->entry );
-    RtlLeaveCriticalSection( &dynamic_unwind_section );
-
+    if (!add_dynamic_unwind_entry( entry ))
+    {
+        RtlFreeHeap( GetProcessHeap(), 0, entry );
+        return FALSE;
+    }
     return TRUE;
 }
 
@@ -169,9 +264,11 @@ NTSTATUS WINAPI RtlAddGrowableFunctionTable( void **table, RUNTIME_FUNCTION *fun
     entry->callback  = NULL;
     entry->context   = NULL;
 
-    RtlEnterCriticalSection( &dynamic_unwind_section );
-    list_add_tail( &dynamic_unwind_list, &entry->entry );
-    RtlLeaveCriticalSection( &dynamic_unwind_section );
+    if (!add_dynamic_unwind_entry( entry ))
+    {
+        RtlFreeHeap( GetProcessHeap(), 0, entry );
+        return STATUS_NO_MEMORY;
+    }
 
     *table = entry;
 
@@ -185,12 +282,14 @@ NTSTATUS WINAPI RtlAddGrowableFunctionTable( void **table, RUNTIME_FUNCTION *fun
 void WINAPI RtlGrowFunctionTable( void *table, DWORD count )
 {
     struct dynamic_unwind_entry *entry;
+    unsigned int i;
 
     TRACE( "%p, %lu\n", table, count );
 
-    RtlEnterCriticalSection( &dynamic_unwind_section );
-    LIST_FOR_EACH_ENTRY( entry, &dynamic_unwind_list, struct dynamic_unwind_entry, entry )
+    RtlAcquireSRWLockExclusive( &dynamic_unwind_lock );
+    for (i = 0; i < dynamic_unwind_count; i++)
     {
+        entry = dynamic_unwind_index[i];
         if (entry == table)
         {
             if (count > entry->count && count <= entry->max_count)
@@ -198,7 +297,7 @@ void WINAPI RtlGrowFunctionTable( void *table, DWORD count )
             break;
         }
     }
-    RtlLeaveCriticalSection( &dynamic_unwind_section );
+    RtlReleaseSRWLockExclusive( &dynamic_unwind_lock );
 }
 
 
@@ -207,21 +306,22 @@ void WINAPI RtlGrowFunctionTable( void *table, DWORD count )
  */
 void WINAPI RtlDeleteGrowableFunctionTable( void *table )
 {
-    struct dynamic_unwind_entry *entry, *to_free = NULL;
+    struct dynamic_unwind_entry *to_free = NULL;
+    unsigned int i;
 
     TRACE( "%p\n", table );
 
-    RtlEnterCriticalSection( &dynamic_unwind_section );
-    LIST_FOR_EACH_ENTRY( entry, &dynamic_unwind_list, struct dynamic_unwind_entry, entry )
+    RtlAcquireSRWLockExclusive( &dynamic_unwind_lock );
+    for (i = 0; i < dynamic_unwind_count; i++)
     {
-        if (entry == table)
+        if (dynamic_unwind_index[i] == table)
         {
-            to_free = entry;
-            list_remove( &entry->entry );
+            to_free = dynamic_unwind_index[i];
+            remove_dynamic_unwind_entry( i );
             break;
         }
     }
-    RtlLeaveCriticalSection( &dynamic_unwind_section );
+    RtlReleaseSRWLockExclusive( &dynamic_unwind_lock );
 
     RtlFreeHeap( GetProcessHeap(), 0, to_free );
 }
@@ -232,21 +332,24 @@ void WINAPI RtlDeleteGrowableFunctionTable( void *table )
  */
 BOOLEAN CDECL RtlDeleteFunctionTable( RUNTIME_FUNCTION *table )
 {
-    struct dynamic_unwind_entry *entry, *to_free = NULL;
+    struct dynamic_unwind_entry *to_free = NULL;
+    unsigned int i, pos = 0;
 
     TRACE( "%p\n", table );
 
-    RtlEnterCriticalSection( &dynamic_unwind_section );
-    LIST_FOR_EACH_ENTRY( entry, &dynamic_unwind_list, struct dynamic_unwind_entry, entry )
+    RtlAcquireSRWLockExclusive( &dynamic_unwind_lock );
+    /* delete the first registered one, as there can be duplicates */
+    for (i = 0; i < dynamic_unwind_count; i++)
     {
-        if (entry->table == table)
+        struct dynamic_unwind_entry *entry = dynamic_unwind_index[i];
+        if (entry->table == table && (!to_free || entry->seq < to_free->seq))
         {
             to_free = entry;
-            list_remove( &entry->entry );
-            break;
+            pos = i;
         }
     }
-    RtlLeaveCriticalSection( &dynamic_unwind_section );
+    if (to_free) remove_dynamic_unwind_entry( pos );
+    RtlReleaseSRWLockExclusive( &dynamic_unwind_lock );
 
     if (!to_free) return FALSE;
 
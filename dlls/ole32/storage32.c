@@ -3986,13 +3986,14 @@ static HRESULT StorageImpl_GetNextBlockInChain(
   ULONG        blockIndex,
   ULONG*       nextBlockIndex)
 {
-  ULONG offsetInDepot    = blockIndex * sizeof (ULONG);
-  ULONG depotBlockCount  = offsetInDepot / This->bigBlockSize;
-  ULONG depotBlockOffset = offsetInDepot % This->bigBlockSize;
+  ULONG blocksPerDepot   = This->bigBlockSize / sizeof(ULONG);
+  ULONG depotBlockCount  = blockIndex / blocksPerDepot;
+  ULONG depotBlockOffset = blockIndex % blocksPerDepot;
   BYTE depotBuffer[MAX_BIG_BLOCK_SIZE];
   ULONG read;
   ULONG depotBlockIndexPos;
-  int index, num_blocks;
+  ULONG *depot;
+  ULONG index;
 
   *nextBlockIndex   = BLOCK_SPECIAL;
 
@@ -4003,12 +4004,32 @@ static HRESULT StorageImpl_GetNextBlockInChain(
   }
 
   /*
-   * Cache the currently accessed depot block.
+   * Make room in the depot cache.
    */
-  if (depotBlockCount != This->indexBlockDepotCached)
+  if (depotBlockCount >= This->blockDepotCacheSize)
   {
-    This->indexBlockDepotCached = depotBlockCount;
+    ULONG new_size = max(This->bigBlockDepotCount, This->blockDepotCacheSize * 2);
+    ULONG **new_cache;
+
+    new_cache = HeapAlloc(GetProcessHeap(), HEAP_ZERO_MEMORY, sizeof(ULONG*) * new_size);
+    if (!new_cache) return E_OUTOFMEMORY;
 
+    if (This->blockDepotCache)
+    {
+      memcpy(new_cache, This->blockDepotCache, sizeof(ULONG*) * This->blockDepotCacheSize);
+      HeapFree(GetProcessHeap(), 0, This->blockDepotCache);
+    }
+
+    This->blockDepotCache = new_cache;
+    This->blockDepotCacheSize = new_size;
+  }
+
+  /*
+   * Load the depot block the first time it is accessed. It stays cached, so
+   * walking chains never has to read the same depot block twice.
+   */
+  if (!(depot = This->blockDepotCache[depotBlockCount]))
+  {
     if (depotBlockCount < COUNT_BBDEPOTINHEADER)
     {
       depotBlockIndexPos = This->bigBlockDepotStart[depotBlockCount];
@@ -4026,20 +4047,37 @@ static HRESULT StorageImpl_GetNextBlockInChain(
     if (!read)
       return STG_E_READFAULT;
 
-    num_blocks = This->bigBlockSize / 4;
+    if (!(depot = HeapAlloc(GetProcessHeap(), 0, sizeof(ULONG) * blocksPerDepot)))
+      return E_OUTOFMEMORY;
 
-    for (index = 0; index < num_blocks; index++)
-    {
-      StorageUtl_ReadDWord(depotBuffer, index*sizeof(ULONG), nextBlockIndex);
-      This->blockDepotCached[index] = *nextBlockIndex;
-    }
+    for (index = 0; index < blocksPerDepot; index++)
+      StorageUtl_ReadDWord(depotBuffer, index*sizeof(ULONG), &depot[index]);
+
+    This->blockDepotCache[depotBlockCount] = depot;
   }
 
-  *nextBlockIndex = This->blockDepotCached[depotBlockOffset/sizeof(ULONG)];
+  *nextBlockIndex = depot[depotBlockOffset];
 
   return S_OK;
 }
 
+/******************************************************************************
+ *      StorageImpl_FreeBlockDepotCache
+ *
+ * Discard the cached contents of the big block depot.
+ */
+static void StorageImpl_FreeBlockDepotCache(StorageImpl* This)
+{
+  ULONG i;
+
+  for (i = 0; i < This->blockDepotCacheSize; i++)
+    HeapFree(GetProcessHeap(), 0, This->blockDepotCache[i]);
+  HeapFree(GetProcessHeap(), 0, This->blockDepotCache);
+
+  This->blockDepotCache = NULL;
+  This->blockDepotCacheSize = 0;
+}
+
 /******************************************************************************
  *      Storage32Impl_GetNextExtendedBlock
  *
@@ -4117,9 +4155,9 @@ static void StorageImpl_SetNextBlockInChain(
   /*
    * Update the cached block depot, if necessary.
    */
-  if (depotBlockCount == This->indexBlockDepotCached)
+  if (depotBlockCount < This->blockDepotCacheSize && This->blockDepotCache[depotBlockCount])
   {
-    This->blockDepotCached[depotBlockOffset/sizeof(ULONG)] = nextBlock;
+    This->blockDepotCache[depotBlockCount][depotBlockOffset/sizeof(ULONG)] = nextBlock;
   }
 }
 
@@ -4654,7 +4692,7 @@ static HRESULT StorageImpl_Refresh(StorageImpl *This, BOOL new_object, BOOL crea
   /*
    * There is no block depot cached yet.
    */
-  This->indexBlockDepotCached = 0xFFFFFFFF;
+  StorageImpl_FreeBlockDepotCache(This);
   This->indexExtBlockDepotCached = 0xFFFFFFFF;
 
   /*
@@ -5157,6 +5195,7 @@ static void StorageImpl_Destroy(StorageBaseImpl* iface)
   StorageImpl_Invalidate(iface);
 
   HeapFree(GetProcessHeap(), 0, This->extBigBlockDepotLocations);
+  StorageImpl_FreeBlockDepotCache(This);
 
   BlockChainStream_Destroy(This->smallBlockRootChain);
   BlockChainStream_Destroy(This->rootBlockChain);
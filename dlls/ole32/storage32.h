@@ -393,8 +393,9 @@ struct StorageImpl
   ULONG extBlockDepotCached[MAX_BIG_BLOCK_SIZE / 4];
   ULONG indexExtBlockDepotCached;
 
-  ULONG blockDepotCached[MAX_BIG_BLOCK_SIZE / 4];
-  ULONG indexBlockDepotCached;
+  /* Contents of the big block depot, loaded one depot block at a time */
+  ULONG **blockDepotCache;
+  ULONG blockDepotCacheSize;
   ULONG prevFreeBlock;
 
   /* All small blocks before this one are known to be in use. */
@@ -7301,8 +7301,10 @@ static void test_register_typelib_64(void)
 
 static void test_LoadTypeLib(void)
 {
-    ITypeLib *tl;
+    WCHAR path[MAX_PATH], temp_path[MAX_PATH], path1[MAX_PATH], path2[MAX_PATH];
+    ITypeLib *tl, *tl2;
     HRESULT hres;
+    BOOL ret;
 
     static const WCHAR kernel32_dllW[] = {'k','e','r','n','e','l','3','2','.','d','l','l',0};
 
@@ -7324,6 +7326,41 @@ static void test_LoadTypeLib(void)
     hres = LoadTypeLibEx(NULL, REGKIND_NONE, &tl);
     ok(hres == E_INVALIDARG, "Got %#lx.\n", hres);
     ok(tl == (void *)0xdeadbeef, "Got %p.\n", tl);
+
+    /* loaded typelibs are shared within the process */
+    hres = LoadTypeLib(L"stdole2.tlb", &tl);
+    ok(hres == S_OK, "Got %#lx.\n", hres);
+    GetSystemDirectoryW(path, ARRAY_SIZE(path));
+    lstrcatW(path, L"\\STDOLE2.TLB");
+    hres = LoadTypeLib(path, &tl2);
+    ok(hres == S_OK, "Got %#lx.\n", hres);
+    ok(tl2 == tl, "Got %p, expected %p.\n", tl2, tl);
+    ITypeLib_Release(tl2);
+    ITypeLib_Release(tl);
+
+    /* also when the same file is reached through a hard link */
+    GetTempPathW(ARRAY_SIZE(temp_path), temp_path);
+    lstrcpyW(path1, temp_path);
+    lstrcatW(path1, L"tl_link1.tlb");
+    lstrcpyW(path2, temp_path);
+    lstrcatW(path2, L"tl_link2.tlb");
+    ret = CopyFileW(path, path1, FALSE);
+    ok(ret, "CopyFile failed %lu.\n", GetLastError());
+    if (!CreateHardLinkW(path2, path1, NULL))
+    {
+        skip("Failed to create a hard link, error %lu.\n", GetLastError());
+        DeleteFileW(path1);
+        return;
+    }
+    hres = LoadTypeLib(path1, &tl);
+    ok(hres == S_OK, "Got %#lx.\n", hres);
+    hres = LoadTypeLib(path2, &tl2);
+    ok(hres == S_OK, "Got %#lx.\n", hres);
+    ok(tl2 == tl || broken(tl2 != tl), "Got %p, expected %p.\n", tl2, tl);
+    ITypeLib_Release(tl2);
+    ITypeLib_Release(tl);
+    DeleteFileW(path2);
+    DeleteFileW(path1);
 }
 
 static void test_SetVarHelpContext(void)
@@ -1102,10 +1102,12 @@ typedef struct tagITypeLibImpl
     HREFTYPE dispatch_href;     /* reference to IDispatch, -1 if unused */
 
 
-    /* typelibs are cached, keyed by path and index, so store the linked list info within them */
+    /* typelibs are cached, keyed by path or file identity and index, so store the linked list info within them */
     struct list entry;
     WCHAR *path;
     INT index;
+    DWORD volume;               /* volume serial number of the file */
+    ULONGLONG file_id;          /* file index on the volume, 0 if unknown */
 } ITypeLibImpl;
 
 static const ITypeLib2Vtbl tlbvt;
@@ -3279,6 +3281,22 @@ static HRESULT TLB_Mapping_Open(LPCWSTR path, LPVOID *ppBase, DWORD *pdwTLBLengt
  */
 
 #define SLTG_SIGNATURE 0x47544c53 /* "SLTG" */
+
+/* must be called with cache_section held */
+static ITypeLibImpl *tlb_cache_find(const WCHAR *path, INT index, DWORD volume, ULONGLONG file_id)
+{
+    ITypeLibImpl *entry;
+
+    LIST_FOR_EACH_ENTRY(entry, &tlb_cache, ITypeLibImpl, entry)
+    {
+        if (entry->index != index) continue;
+        /* the same file may be reached through different paths (short names, links, etc.) */
+        if (file_id && entry->volume == volume && entry->file_id == file_id) return entry;
+        if (!wcsicmp(entry->path, path)) return entry;
+    }
+    return NULL;
+}
+
 static HRESULT TLB_ReadTypeLib(LPCWSTR pszFileName, LPWSTR pszPath, UINT cchPath, ITypeLib2 **ppTypeLib)
 {
     ITypeLibImpl *entry;
@@ -3288,6 +3306,9 @@ static HRESULT TLB_ReadTypeLib(LPCWSTR pszFileName, LPWSTR pszPath, UINT cchPath
     LPVOID pBase = NULL;
     DWORD dwTLBLength = 0;
     IUnknown *pFile = NULL;
+    BY_HANDLE_FILE_INFORMATION info;
+    ULONGLONG file_id = 0;
+    DWORD volume = 0;
     HANDLE h;
 
     *ppTypeLib = NULL;
@@ -3326,23 +3347,25 @@ static HRESULT TLB_ReadTypeLib(LPCWSTR pszFileName, LPWSTR pszPath, UINT cchPath
     h = CreateFileW(pszPath, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
     if(h != INVALID_HANDLE_VALUE){
         GetFinalPathNameByHandleW(h, pszPath, cchPath, FILE_NAME_NORMALIZED | VOLUME_NAME_DOS);
+        if (GetFileInformationByHandle(h, &info))
+        {
+            volume = info.dwVolumeSerialNumber;
+            file_id = ((ULONGLONG)info.nFileIndexHigh << 32) | info.nFileIndexLow;
+        }
         CloseHandle(h);
     }
 
     TRACE_(typelib)("File %s index %d\n", debugstr_w(pszPath), index);
 
-    /* We look the path up in the typelib cache. If found, we just addref it, and return the pointer. */
+    /* We look the file up in the typelib cache. If found, we just addref it, and return the pointer. */
     EnterCriticalSection(&cache_section);
-    LIST_FOR_EACH_ENTRY(entry, &tlb_cache, ITypeLibImpl, entry)
+    if ((entry = tlb_cache_find(pszPath, index, volume, file_id)))
     {
-        if (!wcsicmp(entry->path, pszPath) && entry->index == index)
-        {
-            TRACE("cache hit\n");
-            *ppTypeLib = &entry->ITypeLib2_iface;
-            ITypeLib2_AddRef(*ppTypeLib);
-            LeaveCriticalSection(&cache_section);
-            return S_OK;
-        }
+        TRACE("cache hit\n");
+        *ppTypeLib = &entry->ITypeLib2_iface;
+        ITypeLib2_AddRef(*ppTypeLib);
+        LeaveCriticalSection(&cache_section);
+        return S_OK;
     }
     LeaveCriticalSection(&cache_section);
 
@@ -3376,15 +3399,27 @@ static HRESULT TLB_ReadTypeLib(LPCWSTR pszFileName, LPWSTR pszPath, UINT cchPath
     if(*ppTypeLib) {
 	ITypeLibImpl *impl = impl_from_ITypeLib2(*ppTypeLib);
 
-	TRACE("adding to cache\n");
 	impl->path = wcsdup(pszPath);
-	/* We should really canonicalise the path here. */
         impl->index = index;
+        impl->volume = volume;
+        impl->file_id = file_id;
 
-        /* FIXME: check if it has added already in the meantime */
         EnterCriticalSection(&cache_section);
-        list_add_head(&tlb_cache, &impl->entry);
-        LeaveCriticalSection(&cache_section);
+        if ((entry = tlb_cache_find(pszPath, index, volume, file_id)))
+        {
+            /* another thread loaded it in the meantime, share its instance */
+            TRACE("already added, using %p\n", entry);
+            ITypeLib2_AddRef(&entry->ITypeLib2_iface);
+            LeaveCriticalSection(&cache_section);
+            ITypeLib2_Release(*ppTypeLib);
+            *ppTypeLib = &entry->ITypeLib2_iface;
+        }
+        else
+        {
+            TRACE("adding to cache\n");
+            list_add_head(&tlb_cache, &impl->entry);
+            LeaveCriticalSection(&cache_section);
+        }
         ret = S_OK;
     }
     else
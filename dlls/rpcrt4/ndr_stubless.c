@@ -521,6 +521,10 @@ void client_do_args( PMIDL_STUB_MESSAGE pStubMsg, PFORMAT_STRING pFormat, enum s
                 RpcRaiseException(RPC_X_NULL_REF_POINTER);
             if (params[i].attr.IsIn) call_buffer_sizer(pStubMsg, pArg, &params[i]);
             break;
+        case STUBLESS_CHECKREF:
+            if (params[i].attr.IsSimpleRef && !*(unsigned char **)pArg)
+                RpcRaiseException(RPC_X_NULL_REF_POINTER);
+            break;
         case STUBLESS_MARSHAL:
             if (params[i].attr.IsIn) call_marshaller(pStubMsg, pArg, &params[i]);
             break;
@@ -705,7 +709,8 @@ static void CALLBACK ndr_client_call_finally(BOOL normal, void *arg)
 static LONG_PTR ndr_client_call( const MIDL_STUB_DESC *stub_desc, const PFORMAT_STRING format,
         const PFORMAT_STRING handle_format, void **stack_top, BOOLEAN fpu_args, MIDL_STUB_MESSAGE *stub_msg,
         unsigned short procedure_number, unsigned short stack_size, unsigned int number_of_params,
-        INTERPRETER_OPT_FLAGS Oif_flags, INTERPRETER_OPT_FLAGS2 ext_flags, const NDR_PROC_HEADER *proc_header )
+        INTERPRETER_OPT_FLAGS Oif_flags, INTERPRETER_OPT_FLAGS2 ext_flags, const NDR_PROC_HEADER *proc_header,
+        const NDR_PROC_PARTIAL_OIF_HEADER *oif_header )
 {
     struct ndr_client_call_ctx finally_ctx;
     RPC_MESSAGE rpc_msg;
@@ -791,9 +796,20 @@ static LONG_PTR ndr_client_call( const MIDL_STUB_DESC *stub_desc, const PFORMAT_
         }
 
         /* 2. CALCSIZE */
-        TRACE( "CALCSIZE\n" );
-        client_do_args(stub_msg, format, STUBLESS_CALCSIZE, fpu_args,
-                       number_of_params, (unsigned char *)&retval);
+        if (oif_header && !Oif_flags.ClientMustSize)
+        {
+            /* the size is constant and was computed by MIDL, only check the ref pointers */
+            TRACE( "CHECKREF\n" );
+            client_do_args(stub_msg, format, STUBLESS_CHECKREF, fpu_args,
+                           number_of_params, (unsigned char *)&retval);
+            stub_msg->BufferLength = oif_header->constant_client_buffer_size;
+        }
+        else
+        {
+            TRACE( "CALCSIZE\n" );
+            client_do_args(stub_msg, format, STUBLESS_CALCSIZE, fpu_args,
+                           number_of_params, (unsigned char *)&retval);
+        }
 
         /* 3. GETBUFFER */
         TRACE( "GETBUFFER\n" );
@@ -866,6 +882,7 @@ LONG_PTR WINAPI NdrpClientCall2( PMIDL_STUB_DESC pStubDesc, PFORMAT_STRING pForm
     /* the value to return to the client from the remote procedure */
     LONG_PTR RetVal = 0;
     PFORMAT_STRING pHandleFormat;
+    const NDR_PROC_PARTIAL_OIF_HEADER *pOIFHeader = NULL;
     NDR_PARAM_OIF old_args[256];
 
     TRACE("pStubDesc %p, pFormat %p, ...\n", pStubDesc, pFormat);
@@ -898,9 +915,7 @@ LONG_PTR WINAPI NdrpClientCall2( PMIDL_STUB_DESC pStubDesc, PFORMAT_STRING pForm
 
     if (is_oicf_stubdesc(pStubDesc))  /* -Oicf format */
     {
-        const NDR_PROC_PARTIAL_OIF_HEADER *pOIFHeader =
-            (const NDR_PROC_PARTIAL_OIF_HEADER *)pFormat;
-
+        pOIFHeader = (const NDR_PROC_PARTIAL_OIF_HEADER *)pFormat;
         Oif_flags = pOIFHeader->Oi2Flags;
         number_of_params = pOIFHeader->number_of_params;
 
@@ -928,7 +943,7 @@ LONG_PTR WINAPI NdrpClientCall2( PMIDL_STUB_DESC pStubDesc, PFORMAT_STRING pForm
         {
             RetVal = ndr_client_call(pStubDesc, pFormat, pHandleFormat,
                                      stack_top, fpu_args, &stubMsg, procedure_number, stack_size,
-                                     number_of_params, Oif_flags, ext_flags, pProcHeader);
+                                     number_of_params, Oif_flags, ext_flags, pProcHeader, pOIFHeader);
         }
         __EXCEPT_ALL
         {
@@ -947,7 +962,7 @@ LONG_PTR WINAPI NdrpClientCall2( PMIDL_STUB_DESC pStubDesc, PFORMAT_STRING pForm
         {
             RetVal = ndr_client_call(pStubDesc, pFormat, pHandleFormat,
                                      stack_top, fpu_args, &stubMsg, procedure_number, stack_size,
-                                     number_of_params, Oif_flags, ext_flags, pProcHeader);
+                                     number_of_params, Oif_flags, ext_flags, pProcHeader, pOIFHeader);
         }
         __EXCEPT_ALL
         {
@@ -980,7 +995,7 @@ LONG_PTR WINAPI NdrpClientCall2( PMIDL_STUB_DESC pStubDesc, PFORMAT_STRING pForm
     {
         RetVal = ndr_client_call(pStubDesc, pFormat, pHandleFormat,
                                  stack_top, fpu_args, &stubMsg, procedure_number, stack_size,
-                                 number_of_params, Oif_flags, ext_flags, pProcHeader);
+                                 number_of_params, Oif_flags, ext_flags, pProcHeader, pOIFHeader);
     }
 
     TRACE("RetVal = 0x%Ix\n", RetVal);
@@ -1442,9 +1457,16 @@ LONG WINAPI NdrStubCall2(
                 stubMsg.Buffer = pRpcMsg->Buffer;
             }
             break;
+        case STUBLESS_CALCSIZE:
+            if (pOIFHeader && !Oif_flags.ServerMustSize)
+            {
+                /* the size is constant and was computed by MIDL */
+                stubMsg.BufferLength = pOIFHeader->constant_server_buffer_size;
+                break;
+            }
+            /* fall through */
         case STUBLESS_UNMARSHAL:
         case STUBLESS_INITOUT:
-        case STUBLESS_CALCSIZE:
         case STUBLESS_MARSHAL:
         case STUBLESS_MUSTFREE:
         case STUBLESS_FREE:
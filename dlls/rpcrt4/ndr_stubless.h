@@ -250,7 +250,8 @@ enum stubless_phase
     STUBLESS_GETBUFFER,
     STUBLESS_MARSHAL,
     STUBLESS_MUSTFREE,
-    STUBLESS_FREE
+    STUBLESS_FREE,
+    STUBLESS_CHECKREF
 };
 
 void client_do_args( PMIDL_STUB_MESSAGE pStubMsg, PFORMAT_STRING pFormat, enum stubless_phase phase,
@@ -468,6 +468,80 @@ static int rpcrt4_conn_np_wait_for_incoming_data(RpcConnection *conn)
     return rpcrt4_conn_np_read(conn, NULL, 0);
 }
 
+/* The pipes are in message mode and every fragment is written with a single
+ * write, so read it in one go instead of reading the common header, the rest
+ * of the header and the payload separately. */
+static RPC_STATUS rpcrt4_conn_np_receive_fragment(RpcConnection *conn, RpcPktHdr **Header, void **Payload)
+{
+    unsigned char buffer[RPC_MAX_PACKET_SIZE];
+    const RpcPktCommonHdr *common_hdr = (const RpcPktCommonHdr *)buffer;
+    DWORD hdr_length, data_length;
+    RPC_STATUS status;
+    int len, count;
+
+    *Header = NULL;
+    *Payload = NULL;
+
+    TRACE("(%p, %p, %p)\n", conn, Header, Payload);
+
+    len = rpcrt4_conn_np_read(conn, buffer, sizeof(buffer));
+    if (len < (int)sizeof(*common_hdr))
+    {
+        WARN("Short read of header, %d bytes\n", len);
+        return RPC_S_CALL_FAILED;
+    }
+
+    status = RPCRT4_ValidateCommonHeader(common_hdr);
+    if (status != RPC_S_OK) return status;
+
+    if (len > common_hdr->frag_len)
+    {
+        WARN("message longer than fragment, %d/%d bytes\n", len, common_hdr->frag_len);
+        return RPC_S_PROTOCOL_ERROR;
+    }
+
+    hdr_length = RPCRT4_GetHeaderSize((const RpcPktHdr *)common_hdr);
+    data_length = common_hdr->frag_len - hdr_length;
+
+    *Header = malloc(hdr_length);
+    if (data_length) *Payload = malloc(data_length);
+    if (!*Header || (data_length && !*Payload))
+    {
+        status = RPC_S_OUT_OF_RESOURCES;
+        goto fail;
+    }
+
+    /* larger fragments are left in the pipe, read the remaining data */
+    count = min(len, hdr_length);
+    memcpy(*Header, buffer, count);
+    if (count < hdr_length &&
+        rpcrt4_conn_np_read(conn, (unsigned char *)*Header + count, hdr_length - count) != hdr_length - count)
+    {
+        WARN("bad header length, %d bytes, hdr_length %ld\n", len, hdr_length);
+        status = RPC_S_CALL_FAILED;
+        goto fail;
+    }
+
+    count = len - count;
+    if (count) memcpy(*Payload, buffer + hdr_length, count);
+    if (count < data_length &&
+        rpcrt4_conn_np_read(conn, (unsigned char *)*Payload + count, data_length - count) != data_length - count)
+    {
+        WARN("bad data length, %d/%ld\n", len, common_hdr->frag_len - hdr_length);
+        status = RPC_S_CALL_FAILED;
+        goto fail;
+    }
+
+    return RPC_S_OK;
+
+fail:
+    free(*Header);
+    *Header = NULL;
+    free(*Payload);
+    *Payload = NULL;
+    return status;
+}
+
 static size_t rpcrt4_ncacn_np_get_top_of_tower(unsigned char *tower_data,
                                                const char *networkaddr,
                                                const char *endpoint)
@@ -3131,7 +3205,7 @@ static const struct connection_ops conn_protseq_list[] = {
     rpcrt4_conn_np_wait_for_incoming_data,
     rpcrt4_ncacn_np_get_top_of_tower,
     rpcrt4_ncacn_np_parse_top_of_tower,
-    NULL,
+    rpcrt4_conn_np_receive_fragment,
     RPCRT4_default_is_authorized,
     RPCRT4_default_authorize,
     RPCRT4_default_secure_packet,
@@ -3154,7 +3228,7 @@ static const struct connection_ops conn_protseq_list[] = {
     rpcrt4_conn_np_wait_for_incoming_data,
     rpcrt4_ncalrpc_get_top_of_tower,
     rpcrt4_ncalrpc_parse_top_of_tower,
-    NULL,
+    rpcrt4_conn_np_receive_fragment,
     rpcrt4_ncalrpc_is_authorized,
     rpcrt4_ncalrpc_authorize,
     rpcrt4_ncalrpc_secure_packet,
@@ -2112,6 +2112,30 @@ static void test_handle_return(void)
     test_handle(handle2);
 }
 
+static void test_null_ref_pointer(void)
+{
+    DWORD code = 0;
+    int x;
+
+    /* square_ref() has a constant client buffer size, so the interpreter
+     * skips the sizing pass but must still reject a NULL [ref] pointer
+     * before getting a buffer. */
+    RpcTryExcept
+    {
+        square_ref(NULL);
+    }
+    RpcExcept(TRUE)
+    {
+        code = RpcExceptionCode();
+    }
+    RpcEndExcept
+    ok(code == RPC_X_NULL_REF_POINTER, "got %lu\n", code);
+
+    x = 5;
+    square_ref(&x);
+    ok(x == 25, "got %d\n", x);
+}
+
 static void
 run_tests(void)
 {
@@ -2268,6 +2292,7 @@ client(const char *test)
 
     test_is_server_listening(IInterpServer_IfHandle, RPC_S_OK);
     run_tests();
+    test_null_ref_pointer();
     authinfo_test(RPC_PROTSEQ_NMP, 0);
     test_I_RpcBindingInqLocalClientPID(RPC_PROTSEQ_NMP, IInterpServer_IfHandle);
     test_is_server_listening(IInterpServer_IfHandle, RPC_S_OK);
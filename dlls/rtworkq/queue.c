@@ -336,14 +336,21 @@ static HRESULT pool_queue_init(const struct queue_desc *desc, struct queue *queu
 {
     TP_CALLBACK_ENVIRON_V3 env;
     unsigned int max_thread, i;
+    SYSTEM_INFO info;
+    TP_POOL *pool;
 
-    queue->pool = CreateThreadpool(NULL);
+    if (!(pool = CreateThreadpool(NULL)))
+        return HRESULT_FROM_WIN32(GetLastError());
 
     memset(&env, 0, sizeof(env));
     env.Version = 3;
     env.Size = sizeof(env);
-    env.Pool = queue->pool;
-    env.CleanupGroup = CreateThreadpoolCleanupGroup();
+    env.Pool = pool;
+    if (!(env.CleanupGroup = CreateThreadpoolCleanupGroup()))
+    {
+        CloseThreadpool(pool);
+        return HRESULT_FROM_WIN32(GetLastError());
+    }
     env.CleanupGroupCancelCallback = standard_queue_cleanup_callback;
     env.CallbackPriority = TP_CALLBACK_PRIORITY_NORMAL;
     for (i = 0; i < ARRAY_SIZE(queue->envs); ++i)
@@ -351,17 +358,24 @@ static HRESULT pool_queue_init(const struct queue_desc *desc, struct queue *queu
         queue->envs[i] = env;
         queue->envs[i].CallbackPriority = priorities[i];
     }
-    list_init(&queue->pending_items);
-    InitializeCriticalSection(&queue->cs);
 
-    max_thread = (desc->queue_type == RTWQ_STANDARD_WORKQUEUE || desc->queue_type == RTWQ_WINDOW_WORKQUEUE) ? 1 : 4;
+    if (desc->queue_type == RTWQ_STANDARD_WORKQUEUE || desc->queue_type == RTWQ_WINDOW_WORKQUEUE)
+        max_thread = 1;
+    else
+    {
+        GetSystemInfo(&info);
+        max_thread = max(4, info.dwNumberOfProcessors);
+    }
 
-    SetThreadpoolThreadMinimum(queue->pool, 1);
-    SetThreadpoolThreadMaximum(queue->pool, max_thread);
+    SetThreadpoolThreadMinimum(pool, 1);
+    SetThreadpoolThreadMaximum(pool, max_thread);
 
     if (desc->queue_type == RTWQ_WINDOW_WORKQUEUE)
         FIXME("RTWQ_WINDOW_WORKQUEUE is not supported.\n");
 
+    /* system queues are used without locking once the pool is set */
+    InterlockedExchangePointer((void **)&queue->pool, pool);
+
     return S_OK;
 }
 
@@ -624,16 +638,22 @@ static struct work_item * alloc_work_item(struct queue *queue, LONG priority, IR
     return item;
 }
 
-static void init_work_queue(const struct queue_desc *desc, struct queue *queue)
+static HRESULT init_work_queue(const struct queue_desc *desc, struct queue *queue)
 {
+    HRESULT hr;
+
     assert(desc->ops != NULL);
 
     queue->ops = desc->ops;
-    if (SUCCEEDED(queue->ops->init(desc, queue)))
+    list_init(&queue->pending_items);
+    InitializeCriticalSection(&queue->cs);
+    if (FAILED(hr = queue->ops->init(desc, queue)))
     {
-        list_init(&queue->pending_items);
-        InitializeCriticalSection(&queue->cs);
+        WARN("Failed to initialize queue, hr %#lx.\n", hr);
+        DeleteCriticalSection(&queue->cs);
     }
+
+    return hr;
 }
 
 static HRESULT grab_queue(DWORD queue_id, struct queue **ret)
@@ -641,6 +661,7 @@ static HRESULT grab_queue(DWORD queue_id, struct queue **ret)
     struct queue *queue = get_system_queue(queue_id);
     RTWQ_WORKQUEUE_TYPE queue_type;
     struct queue_handle *entry;
+    HRESULT hr;
 
     *ret = NULL;
 
@@ -657,6 +678,13 @@ static HRESULT grab_queue(DWORD queue_id, struct queue **ret)
         struct queue_desc desc;
 
         EnterCriticalSection(&queues_section);
+        /* another thread may have initialized it in the meantime */
+        if (queue->pool)
+        {
+            LeaveCriticalSection(&queues_section);
+            *ret = queue;
+            return S_OK;
+        }
         switch (queue_id)
         {
             case RTWQ_CALLBACK_QUEUE_IO:
@@ -671,8 +699,10 @@ static HRESULT grab_queue(DWORD queue_id, struct queue **ret)
         desc.queue_type = queue_type;
         desc.ops = &pool_queue_ops;
         desc.target_queue = 0;
-        init_work_queue(&desc, queue);
+        hr = init_work_queue(&desc, queue);
         LeaveCriticalSection(&queues_section);
+        if (FAILED(hr))
+            return hr;
         *ret = queue;
         return S_OK;
     }
@@ -967,6 +997,7 @@ static HRESULT alloc_user_queue(const struct queue_desc *desc, DWORD *queue_id)
     struct queue_handle *entry;
     struct queue *queue;
     unsigned int idx;
+    HRESULT hr;
 
     *queue_id = RTWQ_CALLBACK_QUEUE_UNDEFINED;
 
@@ -976,7 +1007,11 @@ static HRESULT alloc_user_queue(const struct queue_desc *desc, DWORD *queue_id)
     if (!(queue = calloc(1, sizeof(*queue))))
         return E_OUTOFMEMORY;
 
-    init_work_queue(desc, queue);
+    if (FAILED(hr = init_work_queue(desc, queue)))
+    {
+        free(queue);
+        return hr;
+    }
 
     EnterCriticalSection(&queues_section);
 
@@ -97,8 +97,8 @@ struct vcomp_team_data
     va_list                 valist;
 
     /* barrier */
-    unsigned int            barrier;
-    int                     barrier_count;
+    LONG                    barrier;
+    LONG                    barrier_count;
 };
 
 struct vcomp_task_data
@@ -906,26 +906,31 @@ void CDECL _vcomp_flush(void)
 void CDECL _vcomp_barrier(void)
 {
     struct vcomp_team_data *team_data = vcomp_init_thread_data()->team;
+    LONG barrier;
+    int i;
 
     TRACE("()\n");
 
     if (!team_data)
         return;
 
-    EnterCriticalSection(&vcomp_section);
-    if (++team_data->barrier_count >= team_data->num_threads)
+    barrier = ReadAcquire(&team_data->barrier);
+    if (InterlockedIncrement(&team_data->barrier_count) >= team_data->num_threads)
     {
-        team_data->barrier++;
         team_data->barrier_count = 0;
-        WakeAllConditionVariable(&team_data->cond);
+        InterlockedIncrement(&team_data->barrier);
+        RtlWakeAddressAll(&team_data->barrier);
+        return;
     }
-    else
+
+    /* spin for a short while first if each thread can have its own processor */
+    if (team_data->num_threads <= vcomp_num_procs)
     {
-        unsigned int barrier = team_data->barrier;
-        while (team_data->barrier == barrier)
-            SleepConditionVariableCS(&team_data->cond, &vcomp_section, INFINITE);
+        for (i = 0; i < 4000 && ReadAcquire(&team_data->barrier) == barrier; i++)
+            YieldProcessor();
     }
-    LeaveCriticalSection(&vcomp_section);
+    while (ReadAcquire(&team_data->barrier) == barrier)
+        RtlWaitOnAddress(&team_data->barrier, &barrier, sizeof(barrier), NULL);
 }
 
 void CDECL _vcomp_set_num_threads(int num_threads)
@@ -451,6 +451,19 @@ NTSTATUS WINAPI wow64_NtFsControlFile( UINT *args )
 
     IO_STATUS_BLOCK io;
     NTSTATUS status;
+    DUPLICATE_EXTENTS_DATA extents;
+
+    if (code == FSCTL_DUPLICATE_EXTENTS_TO_FILE && in_buf && in_len >= sizeof(DUPLICATE_EXTENTS_DATA32))
+    {
+        const DUPLICATE_EXTENTS_DATA32 *extents32 = in_buf;
+
+        extents.FileHandle = LongToHandle( extents32->FileHandle );
+        extents.SourceFileOffset = extents32->SourceFileOffset;
+        extents.TargetFileOffset = extents32->TargetFileOffset;
+        extents.ByteCount = extents32->ByteCount;
+        in_buf = &extents;
+        in_len = sizeof(extents);
+    }
 
     status = NtFsControlFile( handle, event, apc_32to64( apc ), apc_param_32to64( apc, apc_param ),
                               iosb_32to64( &io, io32 ), code, in_buf, in_len, out_buf, out_len );
@@ -1159,6 +1159,16 @@ static void reader_skipn(xmlreader *reader, int n)
     }
 }
 
+/* moves cursor forward to given position within currently decoded data */
+static void reader_skip_to(xmlreader *reader, const WCHAR *end)
+{
+    encoded_buffer *buffer = &reader->input->buffer->utf16;
+    const WCHAR *ptr = (WCHAR*)buffer->data + buffer->cur;
+
+    buffer->cur += end - ptr;
+    while (ptr < end) reader_update_position(reader, *ptr++);
+}
+
 /* [3] S ::= (#x20 | #x9 | #xD | #xA)+ */
 static int reader_skipspaces(xmlreader *reader)
 {
@@ -1167,7 +1177,10 @@ static int reader_skipspaces(xmlreader *reader)
 
     while (is_wchar_space(*ptr))
     {
-        reader_skipn(reader, 1);
+        const WCHAR *end = ptr + 1;
+
+        while (is_wchar_space(*end)) end++;
+        reader_skip_to(reader, end);
         ptr = reader_get_ptr(reader);
     }
 
@@ -1561,7 +1574,10 @@ static HRESULT reader_parse_name(xmlreader *reader, strval *name)
 
     while (is_namechar(*ptr))
     {
-        reader_skipn(reader, 1);
+        const WCHAR *end = ptr + 1;
+
+        while (is_namechar(*end)) end++;
+        reader_skip_to(reader, end);
         ptr = reader_get_ptr(reader);
     }
 
@@ -2186,9 +2202,15 @@ static HRESULT reader_parse_attvalue(xmlreader *reader, strval *value)
         }
         else
         {
+            WCHAR *end = ptr;
+
             /* replace all whitespace chars with ' ' */
-            if (is_wchar_space(*ptr)) *ptr = ' ';
-            reader_skipn(reader, 1);
+            while (*end && *end != quote && *end != '<' && *end != '&')
+            {
+                if (is_wchar_space(*end)) *end = ' ';
+                end++;
+            }
+            reader_skip_to(reader, end);
         }
         ptr = reader_get_ptr(reader);
     }
@@ -2462,10 +2484,22 @@ static HRESULT reader_parse_chardata(xmlreader *reader)
         /* this covers a case when text has leading whitespace chars */
         if (!is_wchar_space(*ptr)) reader->nodetype = XmlNodeType_Text;
 
-        if (!reader_cmp(reader, L"&"))
+        if (*ptr == '&')
             reader_parse_reference(reader);
-        else
+        else if (*ptr == ']')
             reader_skipn(reader, 1);
+        else
+        {
+            const WCHAR *end = ptr + 1;
+
+            /* skip a run of plain characters up to the next one that needs a closer look */
+            while (*end && *end != '<' && *end != '&' && *end != ']')
+            {
+                if (!is_wchar_space(*end)) reader->nodetype = XmlNodeType_Text;
+                end++;
+            }
+            reader_skip_to(reader, end);
+        }
 
         ptr = reader_get_ptr(reader);
     }
@@ -728,8 +728,8 @@ static void iosb_destroy( struct object *obj )
     free( iosb->out_data );
 }
 
-/* allocate iosb struct */
-static struct iosb *create_iosb( const void *in_data, data_size_t in_size, data_size_t out_size )
+/* allocate iosb struct, taking ownership of the input data */
+static struct iosb *create_iosb( void *in_data, data_size_t in_size, data_size_t out_size )
 {
     struct iosb *iosb;
 
@@ -738,28 +738,16 @@ static struct iosb *create_iosb( const void *in_data, data_size_t in_size, data_
     iosb->status = STATUS_PENDING;
     iosb->result = 0;
     iosb->in_size = in_size;
-    iosb->in_data = NULL;
+    iosb->in_data = in_data;
     iosb->out_size = out_size;
     iosb->out_data = NULL;
-
-    if (in_size && !(iosb->in_data = memdup( in_data, in_size )))
-    {
-        release_object( iosb );
-        iosb = NULL;
-    }
-
     return iosb;
 }
 
-/* create an async associated with iosb for async-based requests
- * returned async must be passed to async_handoff */
-struct async *create_request_async( struct fd *fd, unsigned int comp_flags, const struct async_data *data, int is_system )
+static struct async *create_iosb_async( struct fd *fd, struct iosb *iosb, unsigned int comp_flags,
+                                        const struct async_data *data, int is_system )
 {
     struct async *async;
-    struct iosb *iosb;
-
-    if (!(iosb = create_iosb( get_req_data(), get_req_data_size(), get_reply_max_size() )))
-        return NULL;
 
     async = create_async( fd, current, data, iosb );
     release_object( iosb );
@@ -778,6 +766,36 @@ struct async *create_request_async( struct fd *fd, unsigned int comp_flags, cons
     return async;
 }
 
+/* create an async associated with iosb for async-based requests
+ * returned async must be passed to async_handoff */
+struct async *create_request_async( struct fd *fd, unsigned int comp_flags, const struct async_data *data, int is_system )
+{
+    data_size_t in_size = get_req_data_size();
+    void *in_data = NULL;
+    struct iosb *iosb;
+
+    if (in_size && !(in_data = memdup( get_req_data(), in_size ))) return NULL;
+    if (!(iosb = create_iosb( in_data, in_size, get_reply_max_size() )))
+    {
+        free( in_data );
+        return NULL;
+    }
+    return create_iosb_async( fd, iosb, comp_flags, data, is_system );
+}
+
+/* same as create_request_async, but the request data is moved to the iosb instead of being copied,
+ * so it can't be accessed through get_req_data() anymore; used for write requests, where it can
+ * then be handed over as is to the reader */
+struct async *create_write_request_async( struct fd *fd, unsigned int comp_flags, const struct async_data *data )
+{
+    data_size_t in_size = get_req_data_size();
+    struct iosb *iosb;
+
+    if (!(iosb = create_iosb( in_size ? current->req_data : NULL, in_size, get_reply_max_size() ))) return NULL;
+    if (in_size) current->req_data = NULL;
+    return create_iosb_async( fd, iosb, comp_flags, data, 0 );
+}
+
 struct iosb *async_get_iosb( struct async *async )
 {
     return async->iosb ? (struct iosb *)grab_object( async->iosb ) : NULL;
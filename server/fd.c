@@ -2819,9 +2819,12 @@ DECL_HANDLER(get_handle_unix_name)
 /* get a Unix fd to access a file */
 DECL_HANDLER(get_handle_fd)
 {
+    struct object *obj;
     struct fd *fd;
 
-    if ((fd = get_handle_fd_obj( current->process, req->handle, 0 )))
+    if (!(obj = get_handle_obj( current->process, req->handle, 0, NULL ))) return;
+
+    if ((fd = get_obj_fd( obj )))
     {
         int unix_fd = get_unix_fd( fd );
         reply->cacheable = fd->cacheable;
@@ -2834,6 +2837,12 @@ DECL_HANDLER(get_handle_fd)
         }
         release_object( fd );
     }
+    else if (obj->ops->get_fd == no_get_fd && !is_magic_handle( req->handle ))
+    {
+        /* the object type can never have an fd, let the client cache the error */
+        reply->cacheable = 1;
+    }
+    release_object( obj );
 }
 
 /* perform a read on a file object */
@@ -2862,7 +2871,7 @@ DECL_HANDLER(write)
 
     if (!fd) return;
 
-    if ((async = create_request_async( fd, fd->comp_flags, &req->async, 0 )))
+    if ((async = create_write_request_async( fd, fd->comp_flags, &req->async )))
     {
         fd->fd_ops->write( fd, async, req->pos );
         reply->wait = async_handoff( async, &reply->size, 0 );
@@ -462,6 +462,12 @@ static inline struct object *get_magic_handle( obj_handle_t handle )
     }
 }
 
+/* check whether a handle is one of the magic pseudo-handles */
+int is_magic_handle( obj_handle_t handle )
+{
+    return get_magic_handle( handle ) != NULL;
+}
+
 /* retrieve the object corresponding to a handle, incrementing its refcount */
 struct object *get_handle_obj( struct process *process, obj_handle_t handle,
                                unsigned int access, const struct object_ops *ops )
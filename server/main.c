@@ -37,6 +37,7 @@
 
 /* command-line options */
 int debug_level = 0;
+int profile_requests = 0;
 int foreground = 0;
 timeout_t master_socket_timeout = 3 * -TICKS_PER_SEC;  /* master socket timeout, default is 3 seconds */
 const char *server_argv0;
@@ -214,9 +215,12 @@ static void sigterm_handler( int signum )
 
 int main( int argc, char *argv[] )
 {
+    const char *env;
+
     setvbuf( stderr, NULL, _IOLBF, 0 );
     server_argv0 = argv[0];
     parse_options( argc, argv, "d::fhk::p::vw", long_options, option_callback );
+    if ((env = getenv( "WINESERVER_PROFILE" ))) profile_requests = atoi( env );
 
     /* setup temporary handlers before the real signal initialization is done */
     signal( SIGPIPE, SIG_IGN );
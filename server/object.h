@@ -306,6 +306,7 @@ extern struct object *create_symlink( struct object *root, const struct unicode_
 
   /* command-line options */
 extern int debug_level;
+extern int profile_requests;
 extern int foreground;
 extern timeout_t master_socket_timeout;
 extern const char *server_argv0;
@@ -696,6 +696,7 @@ struct process *create_process( int fd, struct process *parent, unsigned int fla
     list_init( &process->views );
 
     process->end_time = 0;
+    process->req_profile = NULL;
 
     if (sd && !default_set_sd( &process->obj, sd, OWNER_SECURITY_INFORMATION | GROUP_SECURITY_INFORMATION |
                                DACL_SECURITY_INFORMATION | SACL_SECURITY_INFORMATION ))
@@ -786,6 +787,7 @@ static void process_destroy( struct object *obj )
     free( process->rawinput_devices );
     free( process->dir_cache );
     free( process->image );
+    free( process->req_profile );
 }
 
 /* dump a process on stdout for debugging purposes */
@@ -287,11 +287,27 @@ static void send_reply( union generic_reply *reply )
         fatal_protocol_error( current, "reply write: %s\n", strerror( errno ));
 }
 
+/* return the CPU time used by the server in ns, for request profiling */
+static unsigned long long get_profile_time(void)
+{
+#ifdef HAVE_CLOCK_GETTIME
+    struct timespec ts;
+#ifdef CLOCK_THREAD_CPUTIME_ID
+    if (!clock_gettime( CLOCK_THREAD_CPUTIME_ID, &ts ))
+        return ts.tv_sec * 1000000000ull + ts.tv_nsec;
+#endif
+    if (!clock_gettime( CLOCK_MONOTONIC, &ts ))
+        return ts.tv_sec * 1000000000ull + ts.tv_nsec;
+#endif
+    return monotonic_counter() * 100;
+}
+
 /* call a request handler */
 static void call_req_handler( struct thread *thread )
 {
     union generic_reply reply;
     enum request req = thread->req.request_header.req;
+    unsigned long long start = 0;
 
     current = thread;
     current->reply_size = 0;
@@ -299,12 +315,16 @@ static void call_req_handler( struct thread *thread )
     memset( &reply, 0, sizeof(reply) );
 
     if (debug_level) trace_request();
+    if (profile_requests) start = get_profile_time();
 
     if (req < REQ_NB_REQUESTS)
         req_handlers[req]( &current->req, &reply );
     else
         set_error( STATUS_NOT_IMPLEMENTED );
 
+    if (profile_requests && req < REQ_NB_REQUESTS)
+        profile_request( current ? current->process : NULL, req, get_profile_time() - start );
+
     if (current)
     {
         if (current->reply_fd)
@@ -330,20 +350,40 @@ void read_request( struct thread *thread )
 
     if (!thread->req_toread)  /* no pending request */
     {
-        if ((ret = read( get_unix_fd( thread->request_fd ), &thread->req,
-                         sizeof(thread->req) )) != sizeof(thread->req)) goto error;
+        char buffer[4096];
+        struct iovec vec[2];
+        data_size_t size;
+
+        /* read the data along with the header, it's usually small enough to be already there */
+        vec[0].iov_base = &thread->req;
+        vec[0].iov_len  = sizeof(thread->req);
+        vec[1].iov_base = buffer;
+        vec[1].iov_len  = sizeof(buffer);
+        if ((ret = readv( get_unix_fd( thread->request_fd ), vec, 2 )) < (int)sizeof(thread->req)) goto error;
+        size = ret - sizeof(thread->req);
+
         if (!(thread->req_toread = thread->req.request_header.request_size))
         {
+            if (size) goto too_much_data;
             /* no data, handle request at once */
             call_req_handler( thread );
             return;
         }
+        if (size > thread->req_toread) goto too_much_data;
         if (!(thread->req_data = malloc( thread->req_toread )))
         {
             fatal_protocol_error( thread, "no memory for %u bytes request %d\n",
                                   thread->req_toread, thread->req.request_header.req );
             return;
         }
+        memcpy( thread->req_data, buffer, size );
+        if (!(thread->req_toread -= size))
+        {
+            call_req_handler( thread );
+            free( thread->req_data );
+            thread->req_data = NULL;
+            return;
+        }
     }
 
     /* read the variable sized data */
@@ -370,6 +410,11 @@ error:
         fatal_protocol_error( thread, "partial read %d\n", ret );
     else if (errno != EWOULDBLOCK && (EWOULDBLOCK == EAGAIN || errno != EAGAIN))
         fatal_protocol_error( thread, "read: %s\n", strerror( errno ));
+    return;
+
+too_much_data:
+    fatal_protocol_error( thread, "request %d: got more than %u bytes of data\n",
+                          thread->req.request_header.req, thread->req.request_header.request_size );
 }
 
 /* receive a file descriptor on the process socket */
@@ -65,6 +65,8 @@ extern int server_dir_fd, config_dir_fd;
 
 extern void trace_request(void);
 extern void trace_reply( enum request req, const union generic_reply *reply );
+extern void profile_request( struct process *process, enum request req, unsigned long long elapsed );
+extern void dump_request_profile(void);
 
 /* get current tick count to return to client */
 static inline unsigned int get_tick_count(void)
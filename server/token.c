@@ -42,6 +42,7 @@
 
 #define MAX_SUBAUTH_COUNT 1
 
+const struct luid SeLockMemoryPrivilege           = {  4, 0 };
 const struct luid SeIncreaseQuotaPrivilege        = {  5, 0 };
 const struct luid SeTcbPrivilege                  = {  7, 0 };
 const struct luid SeSecurityPrivilege             = {  8, 0 };
@@ -767,6 +768,7 @@ struct token *token_create_admin( unsigned primary, int impersonation_level, int
         { SeLoadDriverPrivilege, SE_PRIVILEGE_ENABLED },
         { SeCreatePagefilePrivilege, 0 },
         { SeIncreaseQuotaPrivilege, 0 },
+        { SeLockMemoryPrivilege, 0 },
         { SeUndockPrivilege, 0 },
         { SeManageVolumePrivilege, 0 },
         { SeImpersonatePrivilege, SE_PRIVILEGE_ENABLED },
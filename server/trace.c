@@ -23,6 +23,7 @@
 #include <ctype.h>
 #include <stdarg.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <sys/types.h>
 #include <sys/socket.h>
 
@@ -56,6 +57,7 @@
 #include "ws2tcpip.h"
 #include "tcpmib.h"
 #include "file.h"
+#include "process.h"
 #include "request.h"
 #include "security.h"
 #include "unicode.h"
@@ -1594,3 +1596,121 @@ void trace_reply( enum request req, const union generic_reply *reply )
     else fprintf( stderr, "%04x: %d() = %s\n",
                   current->id, req, get_status_name(current->error) );
 }
+
+/* request profiling, enabled with WINESERVER_PROFILE=1 and dumped on SIGUSR1 */
+
+#define PROFILE_BUCKETS 32  /* power of two buckets in ns units */
+#define PROFILE_PROCESS_TOP 5  /* number of requests listed for each process */
+
+struct request_profile
+{
+    unsigned int       count;
+    unsigned long long total;
+    unsigned long long max;
+    unsigned int       buckets[PROFILE_BUCKETS];
+};
+
+struct process_request_profile
+{
+    unsigned int       count;
+    unsigned long long total;
+};
+
+static struct request_profile request_profiles[REQ_NB_REQUESTS];
+
+/* record the CPU time in ns spent handling a request */
+void profile_request( struct process *process, enum request req, unsigned long long elapsed )
+{
+    struct request_profile *prof = &request_profiles[req];
+    unsigned int bucket = 0;
+
+    while (bucket < PROFILE_BUCKETS - 1 && elapsed >> bucket) bucket++;
+    prof->count++;
+    prof->total += elapsed;
+    if (elapsed > prof->max) prof->max = elapsed;
+    prof->buckets[bucket]++;
+
+    if (!process) return;
+    if (!process->req_profile &&
+        !(process->req_profile = calloc( REQ_NB_REQUESTS, sizeof(*process->req_profile) )))
+        return;
+    process->req_profile[req].count++;
+    process->req_profile[req].total += elapsed;
+}
+
+/* return the upper bound in ns of the bucket containing the given percentile */
+static unsigned long long get_profile_percentile( const struct request_profile *prof, unsigned int percent )
+{
+    unsigned int i, total = 0, limit = (prof->count * (unsigned long long)percent + 99) / 100;
+
+    for (i = 0; i < PROFILE_BUCKETS - 1; i++)
+        if ((total += prof->buckets[i]) >= limit) return 1ull << i;
+    return prof->max;
+}
+
+static int compare_request_profiles( const void *p1, const void *p2 )
+{
+    const struct request_profile *prof1 = &request_profiles[*(const enum request *)p1];
+    const struct request_profile *prof2 = &request_profiles[*(const enum request *)p2];
+
+    if (prof1->total > prof2->total) return -1;
+    if (prof1->total < prof2->total) return 1;
+    return 0;
+}
+
+static int dump_process_profile( struct process *process, void *arg )
+{
+    const struct process_request_profile *prof = process->req_profile;
+    enum request top[PROFILE_PROCESS_TOP];
+    unsigned int i, j, count = 0, top_count = 0;
+    unsigned long long total = 0;
+
+    if (!prof) return 0;
+
+    for (i = 0; i < REQ_NB_REQUESTS; i++)
+    {
+        if (!prof[i].count) continue;
+        count += prof[i].count;
+        total += prof[i].total;
+        /* insert into the list of the requests that took the most time */
+        for (j = top_count; j > 0 && prof[top[j - 1]].total < prof[i].total; j--)
+            if (j < PROFILE_PROCESS_TOP) top[j] = top[j - 1];
+        if (j < PROFILE_PROCESS_TOP)
+        {
+            top[j] = i;
+            if (top_count < PROFILE_PROCESS_TOP) top_count++;
+        }
+    }
+
+    fprintf( stderr, "%04x %8d %10u %12.3f ", process->id, process->unix_pid, count, total / 1000000.0 );
+    if (process->image) dump_strW( process->image, process->imagelen, stderr, "\"\"" );
+    fputc( '\n', stderr );
+    for (i = 0; i < top_count; i++)
+        fprintf( stderr, "     %-32s %10u %12.3f\n", req_names[top[i]], prof[top[i]].count,
+                 prof[top[i]].total / 1000000.0 );
+    return 0;
+}
+
+void dump_request_profile(void)
+{
+    enum request reqs[REQ_NB_REQUESTS];
+    unsigned int i, count = 0;
+
+    for (i = 0; i < REQ_NB_REQUESTS; i++) if (request_profiles[i].count) reqs[count++] = i;
+    qsort( reqs, count, sizeof(reqs[0]), compare_request_profiles );
+
+    fprintf( stderr, "%-32s %10s %12s %10s %10s %10s %10s\n",
+             "request", "calls", "cpu(ms)", "avg(us)", "p50(us)", "p99(us)", "max(us)" );
+    for (i = 0; i < count; i++)
+    {
+        const struct request_profile *prof = &request_profiles[reqs[i]];
+
+        fprintf( stderr, "%-32s %10u %12.3f %10.3f %10.3f %10.3f %10.3f\n", req_names[reqs[i]],
+                 prof->count, prof->total / 1000000.0, prof->total / 1000.0 / prof->count,
+                 get_profile_percentile( prof, 50 ) / 1000.0, get_profile_percentile( prof, 99 ) / 1000.0,
+                 prof->max / 1000.0 );
+    }
+
+    fprintf( stderr, "\n%-4s %8s %10s %12s %s\n", "pid", "unix_pid", "calls", "cpu(ms)", "image" );
+    enum_processes( dump_process_profile, NULL );
+}